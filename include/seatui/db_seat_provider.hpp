@@ -0,0 +1,23 @@
+#pragma once
+// ISeatProvider 的数据库实现：快照读 SeatDatabase，分区计数变化经 zoneUpdated 推送
+
+#include "seat_provider.hpp"
+
+class SeatDatabase;
+
+namespace seatui {
+
+class DbSeatProvider : public ISeatProvider {
+    Q_OBJECT
+public:
+    explicit DbSeatProvider(SeatDatabase& db, QObject* parent=nullptr);
+    ~DbSeatProvider() override;
+
+    std::vector<SeatInfo> seats() const override;   // seat_current + seats（roi、zone_id）
+    std::vector<ZoneInfo> zones() const override;   // 内存中的分区计数，O(zones)
+
+private:
+    SeatDatabase& db_;
+};
+
+} // namespace seatui
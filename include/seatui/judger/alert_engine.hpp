@@ -0,0 +1,70 @@
+#ifndef ALERT_ENGINE_HPP
+#define ALERT_ENGINE_HPP
+#pragma once
+#include "data_structures.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AlertEngineConfig {
+    int64_t update_interval_ms = 30000;   // an open alert's row is rewritten at most this often
+    int64_t resolve_after_ms = 5000;      // condition must stay absent this long before the alert closes
+    int64_t flush_interval_ms = 1000;     // judger writes queued rows at most this often (frame time)
+};
+
+// one alert row as written to the alerts table (one row per incident)
+struct AlertRecord {
+    std::string alert_id;          // "<seat>_<type>_<opened ts_ms>", stable for the whole incident
+    std::string seat_id;
+    std::string alert_type;
+    std::string alert_desc;
+    int64_t opened_ms = 0;
+    int64_t last_ms = 0;           // last frame the condition was seen
+    int duration_sec = 0;
+    int64_t resolved_ms = 0;       // 0 = still open
+};
+
+// turns the judger's per-frame alert signals into incidents
+//   - keeps one open alert per (seat, type); repeated signals only update its duration
+//   - a signal that disappears for less than resolve_after_ms continues the same incident
+//   - row writes are coalesced: open / close immediately, updates at most every update_interval_ms,
+//     and several changes of one alert before takePending() collapse into one row write
+// not thread-safe: driven by the judger's writer thread
+class AlertEngine {
+public:
+    explicit AlertEngine(const AlertEngineConfig& cfg = AlertEngineConfig()) : cfg_(cfg) {}
+
+    void setConfig(const AlertEngineConfig& cfg) { cfg_ = cfg; }
+
+    // one judged seat: raised = alert signals of this frame (empty = no alert condition)
+    void observe(const std::string& seat_id, const std::vector<B2CD_Alert>& raised, int64_t ts_ms);
+
+    // re-open an incident persisted before a restart (nothing is queued)
+    void restoreOpen(const AlertRecord& rec);
+
+    // queue the latest state of every open alert (end of replay / shutdown), bypassing the rate limit
+    void queueOpen();
+
+    // rows to write since the last call, in first-change order
+    void takePending(std::vector<AlertRecord>& out);
+    size_t pendingCount() const { return pending_order_.size(); }
+    size_t openCount() const { return open_count_; }
+
+private:
+    struct OpenAlert {
+        AlertRecord rec;
+        int64_t written_ms = 0;     // last time the row was queued
+        int64_t absent_since = 0;   // first frame without the signal, 0 = present
+    };
+
+    void queue(const AlertRecord& rec);
+
+    AlertEngineConfig cfg_;
+    std::unordered_map<std::string, std::vector<OpenAlert>> open_;   // seat_id -> open alerts (by type)
+    size_t open_count_ = 0;
+    std::unordered_map<std::string, size_t> pending_index_;          // alert_id -> slot in pending_order_
+    std::vector<AlertRecord> pending_order_;
+};
+
+#endif
@@ -6,6 +6,8 @@
 #include <string>
 #include <vector>
 #include <optional>            
+#include <cstdint>
+#include "seatui/vision/Enums.h"
 
 // get A's person_boxes/object_boxes
 struct DetectedObject {
@@ -13,6 +15,7 @@ struct DetectedObject {
     cv::Rect bbox;           // x/y/w/h
     float score;             // conf
     int class_id;            // cls_id
+    int track_id = -1;       // A's tracker id, stable across frames (-1 = untracked)
 };
 
 // get A's A2B_Data structure
@@ -23,10 +26,24 @@ struct A2B_Data {
     std::vector<cv::Point2i> seat_poly;    // seat_poly
     std::vector<DetectedObject> person_boxes; 
     std::vector<DetectedObject> object_boxes; 
-    std::string timestamp;                 // ts_ms
+    int64_t ts_ms = 0;                     // ts_ms (epoch ms, formatted only at the UI edge)
     cv::Mat frame;                         // image_path
 };
 
+// B's per-seat judging input, independent of transport
+// (filled straight from vision::SeatFrameState in-process, or from a JSONL seat object)
+struct SeatObservation {
+    std::string seat_id;                   // normalized "S<id>"
+    int32_t seat_idx = -1;                 // judger's interned index (-1 = intern from seat_id)
+    int frame_id = 0;
+    int64_t ts_ms = 0;
+    int person_count = 0;
+    int object_count = 0;
+    vision::SeatOccupancyState occupancy = vision::SeatOccupancyState::FREE;
+    float person_conf = 0.95f;
+    float object_conf = 0.85f;
+};
+
 // B's state to C/D
 struct B2CD_State {
     std::string seat_id;                   
@@ -37,18 +54,19 @@ struct B2CD_State {
     } status;
     int status_duration;               
     float confidence;                      
-    std::string timestamp;                 
+    int64_t ts_ms = 0;                     
     int source_frame_id;                  
 };
 
 
 // B's alert to C/D
 struct B2CD_Alert {
-    std::string alert_id;                  // seat_id_timestamp
+    std::string alert_id;                  // seat_id_tsms
     std::string seat_id;                   
     std::string alert_type;                // AnomalyOccupied
     std::string alert_desc;                // description
-    std::string timestamp;                 
+    int64_t ts_ms = 0;                     
+    int duration_sec = 0;                  // how long the condition has held
     bool is_processed = false;             
 };
 
@@ -56,7 +74,7 @@ struct B2CD_Alert {
 struct B2C_SeatEvent {
     std::string seat_id;          
     std::string state;            
-    std::string timestamp;        
+    int64_t ts_ms = 0;            
     int duration_sec;             
 };
 
@@ -65,7 +83,7 @@ struct B2C_SeatSnapshot {
     std::string seat_id;          
     std::string state;            
     int person_count;             
-    std::string timestamp;        
+    int64_t ts_ms = 0;            
 };
 
 #endif 
\ No newline at end of file
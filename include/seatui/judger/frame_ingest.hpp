@@ -0,0 +1,102 @@
+#ifndef FRAME_INGEST_HPP
+#define FRAME_INGEST_HPP
+#pragma once
+#include "seatui/vision/Types.h"
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// B's ingestion unit: either a JSONL file produced by A, or an in-process SeatFrameState batch
+struct JudgerInput {
+    std::string jsonl_path;                       // file handoff (non-empty)
+    std::vector<vision::SeatFrameState> states;   // in-process handoff (jsonl_path empty)
+    bool isFile() const { return !jsonl_path.empty(); }
+};
+
+// blocking MPSC queue: producers = dir watcher / vision::Publisher, consumer = SeatStateJudger
+class JudgerInputQueue {
+public:
+    void push(JudgerInput in) {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (closed_) return;
+            // a file already waiting in the queue will be tailed to its end anyway
+            if (in.isFile()) {
+                for (const auto& q : q_) if (q.jsonl_path == in.jsonl_path) return;
+            }
+            q_.push_back(std::move(in));
+        }
+        cv_.notify_one();
+    }
+
+    // block until an item arrives; false once closed and drained
+    bool pop(JudgerInput& out) {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cv_.wait(lk, [&] { return closed_ || !q_.empty(); });
+        if (q_.empty()) return false;
+        out = std::move(q_.front());
+        q_.pop_front();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            closed_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return q_.size();
+    }
+
+private:
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<JudgerInput> q_;
+    bool closed_ = false;
+};
+
+// watches A's output directory and pushes a *.jsonl file whenever it is created or grows
+//   Linux: inotify (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MODIFY)
+//   otherwise / inotify failure: directory polling every poll_ms
+//   a file is re-offered when its (size, mtime) changed; the judger tails it from its checkpoint
+class JsonlDirWatcher {
+public:
+    JsonlDirWatcher(const std::string& dir, JudgerInputQueue& queue, int poll_ms = 2000);
+    ~JsonlDirWatcher();
+
+    bool start();
+    void stop();
+    bool usingInotify() const { return using_inotify_; }
+
+private:
+    void scanDirectory();                         // initial scan + polling mode
+    void offer(const std::string& filename);      // filter, push if new or changed since last offer
+    void pollLoop();
+#ifdef __linux__
+    void inotifyLoop();
+    int inotify_fd_ = -1;
+    int watch_fd_ = -1;
+#endif
+
+    std::string dir_;
+    JudgerInputQueue& queue_;
+    int poll_ms_;
+    bool using_inotify_ = false;
+    std::atomic<bool> stop_{false};
+    std::thread worker_;
+    // file name -> (size, mtime) at last offer; only touched by worker_ (and start() before launch)
+    std::unordered_map<std::string, std::pair<uintmax_t, long long>> offered_;
+};
+
+#endif
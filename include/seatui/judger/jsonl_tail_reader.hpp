@@ -0,0 +1,46 @@
+#ifndef JSONL_TAIL_READER_HPP
+#define JSONL_TAIL_READER_HPP
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// durable read position inside one JSONL file
+//   offset always points just past the last complete line ('\n') that was consumed
+//   file_id = inode (POSIX) / volume file index (Windows); changes when the file is rotated (replaced)
+//   head_hash = FNV-1a of the first min(offset, kHeadBytes) bytes, catches what file_id cannot:
+//   inode reuse after delete + create, and in-place rewrites (std::ios::trunc) of the same length
+struct TailCheckpoint {
+    std::string source;        // key, file name relative to the watched directory
+    int64_t file_id = 0;       // 0 = never read
+    int64_t offset = 0;
+    int64_t head_hash = 0;
+};
+
+// incremental JSONL reader: returns only the complete lines appended since the checkpoint
+//   - reads in chunk_bytes blocks (fread), no per-line getline on ifstream
+//   - a trailing partial line (writer still busy) is left for the next call
+//   - rotation (file_id / head_hash changed) or truncation (size < offset) restarts from offset 0
+class JsonlTailReader {
+public:
+    explicit JsonlTailReader(size_t chunk_bytes = 1 << 20, size_t max_bytes_per_call = 8 << 20);
+
+    // append complete lines after cp.offset to out_lines (at most ~max_bytes_per_call, but always
+    // at least one whole line if one exists) and advance cp; false if the file cannot be opened
+    bool readNewLines(const std::string& path, TailCheckpoint& cp, std::vector<std::string>& out_lines);
+
+    // true if the last readNewLines() stopped because of max_bytes_per_call (call again for the rest)
+    bool hasMore() const { return has_more_; }
+
+    static constexpr size_t kHeadBytes = 1024;
+
+private:
+    size_t chunk_bytes_;
+    size_t max_bytes_per_call_;
+    bool has_more_ = false;
+    std::vector<char> chunk_;   // reused read buffer
+    std::string carry_;         // partial line spanning two chunks
+};
+
+#endif
@@ -1,7 +1,11 @@
 #ifndef SEAT_STATE_JUDGER_HPP
 #define SEAT_STATE_JUDGER_HPP
 
+#include "alert_engine.hpp"
 #include "data_structures.hpp"
+#include "frame_ingest.hpp"
+#include "jsonl_tail_reader.hpp"
+#include "seat_state_table.hpp"
 #include <opencv2/opencv.hpp>
 #include <vector>
 #include <string>
@@ -9,9 +13,12 @@
 #include <unordered_set>
 #include <optional>
 #include <chrono>
+#include <memory>
 
 
 class SeatDatabase; // forward declare
+class ShardedJudger;
+class SeatDbWriter;
 
 #include <json.hpp> 
 
@@ -24,10 +31,77 @@ const float FG_RATIO_THRESHOLD = 0.05f;
 const int ANOMALY_THRESHOLD_SECONDS = 6;
 const int MORPH_KERNEL_SIZE = 5;
 
+// transition-only output (debounce / hysteresis), a confirmed transition stamped at the frame it began;
+// disabled = legacy event + snapshot for every seat on every frame
+struct JudgerDebounceConfig {
+    bool enable = false;
+    int enter_dwell_ms = 2000;        // raw state must hold this long before Unseated -> Seated/Anomaly (or Seated <-> Anomaly) is confirmed
+    int exit_dwell_ms = 5000;         // ... before Seated/Anomaly -> Unseated (people lean out of view briefly)
+    float person_enter_conf = 0.50f;  // person evidence needed to count as present while not Seated
+    float person_exit_conf = 0.30f;   // while Seated, weaker detections still count as present
+    int heartbeat_sec = 60;           // snapshot of every seat at least this often (0 = only on transitions)
+};
+
+// "debounce" object of a judger JSON config (keys as the fields above); missing keys keep cfg's values.
+// false, cfg untouched, if the file cannot be read or parsed
+bool loadDebounceConfig(const std::string& path, JudgerDebounceConfig& cfg);
+
+// rows handed to the DB writer (counted even when no DB is attached)
+struct JudgerWriteStats {
+    uint64_t frames = 0;
+    uint64_t seat_frames = 0;
+    uint64_t events = 0;
+    uint64_t snapshots = 0;
+    uint64_t alerts = 0;        // alert rows after AlertEngine coalescing
+};
+
 class SeatStateJudger {
 public:
     SeatStateJudger();
-    ~SeatStateJudger() = default;
+    explicit SeatStateJudger(SeatDatabase* db);   // inject DB (nullptr = judge only, no writes; used by tools/benchmarks)
+    ~SeatStateJudger();
+
+    // in-process entry: judge one frame straight from A's structs, no JSON in the loop
+    void processFrame(const std::vector<vision::SeatFrameState>& states);
+
+    // core per-seat judgement shared by every input path; output records carry obs.ts_ms (epoch ms)
+    void judgeSeat(
+        const SeatObservation& obs,
+        struct B2CD_State& state,
+        vector<struct B2CD_Alert>& alerts,
+        optional<struct B2C_SeatSnapshot>& out_snapshot,
+        optional<struct B2C_SeatEvent>& out_event
+    );
+
+    void setDebounce(const JudgerDebounceConfig& cfg);   // also applied to the shard judgers
+    const JudgerWriteStats& writeStats() const { return write_stats_; }
+
+    // state checkpoint: per-seat rows in judger_state, written with the judged rows at most every
+    // interval_ms of frame time (and at the end of replay / run); restoreState() runs in the default ctor
+    bool restoreState();
+    void checkpointState();   // write now, in its own transaction
+    void setStateCheckpointInterval(int64_t interval_ms) { state_checkpoint_interval_ms_ = interval_ms; }
+    SeatStateTable& stateTable() { return seat_state_; }   // used by ShardedJudger for its shard judgers
+
+    // alert incidents (one row per seat/type incident, see AlertEngine)
+    void setAlertConfig(const AlertEngineConfig& cfg);
+    void flushAlerts();   // write the queued alert rows now
+
+    // virtual clock: ts_ms of the newest frame judged so far (0 = none); the judger never reads the wall clock
+    int64_t clockMs() const { return clock_ms_; }
+
+    // replay recorded JSONL as fast as the CPU allows: one file, or every *.jsonl of a directory in
+    // name order, through the same tail/transaction path as run() but without watcher or waits.
+    // Files already covered by the DB's ingest checkpoints are skipped (use a fresh DB for regression runs).
+    // Returns the number of files replayed.
+    size_t replay(const string& jsonl_path);
+
+    void setVerbose(bool v) { verbose_ = v; }   // per-seat console log (on by default)
+
+    // sharded mode: seats judged on `shards` threads, frames buffered up to batch_frames
+    // and written by this thread in sequential order; shards <= 1 = sequential (default)
+    void setShardCount(int shards, size_t batch_frames = 64);
+    void flushShards();   // judge + write every frame still buffered in sharded mode
 
     
     void processAData(
@@ -35,7 +109,7 @@ public:
         const json& seat_j,
         struct B2CD_State& state,
         vector<struct B2CD_Alert>& alerts,
-        struct B2C_SeatSnapshot& out_snapshot,
+        optional<struct B2C_SeatSnapshot>& out_snapshot,
         optional<struct B2C_SeatEvent>& out_event
     );
 
@@ -44,14 +118,25 @@ public:
         vector<json>& out_seat_j_list
     );
 
-    void run(const std::string& jsonl_path = "");
+    // blocking ingestion loop, no timer:
+    //   external_queue == nullptr -> watch jsonl_path directory (inotify on Linux, polling fallback)
+    //   external_queue != nullptr -> consume in-process batches pushed by vision::Publisher
+    void run(const std::string& jsonl_path = "", JudgerInputQueue* external_queue = nullptr);
     string stateToStr(int status_enum); // accepts B2CD_State::SeatStatus(int)
-    string msToISO8601(int64_t ts_ms);
+    string msToISO8601(int64_t ts_ms);   // local "YYYY-MM-DD HH:MM:SS", for logs / tools only
     bool readJsonlFile(
         const string& jsonl_path,
         vector<vector<A2B_Data>>& out_batch_a2b_data,
         vector<vector<json>>& out_batch_seat_j
     );
+    // parse one JSONL line (= one frame); false if the line has no seats (e.g. heartbeat)
+    bool parseJsonlLine(
+        const string& line,
+        vector<A2B_Data>& out_frame_a2b,
+        vector<json>& out_frame_seat_j
+    );
+    // JSONL adapter: convert one parsed frame to SeatObservation and judge it
+    void processFrameBatch(vector<A2B_Data>& frame_a2b, vector<json>& frame_j);
 
     vector<int> getNeedStoreFrameIndexes() const {
         return vector<int>(need_store_frame_indexes_.begin(), need_store_frame_indexes_.end());
@@ -62,30 +147,71 @@ public:
     }
 
 private:
-    // state tracking
-    unordered_map<string, int64_t> last_seat_ts_;
-    unordered_map<string, int> last_seat_status_duration_;
-    unordered_map<string, int> anomaly_occupied_duration_;
-    unordered_map<string, int> last_seat_status_; // store as int (enum value)
+    // state tracking: seat ids interned once, state in flat arrays indexed by SeatIdx
+    SeatIdInterner seat_ids_;
+    SeatStateTable seat_state_;
 
     unordered_set<int> need_store_frame_indexes_;
 
     // DB reference
     SeatDatabase* db_; // pointer to avoid ctor-order issues
 
-    
-    // tracking seat status durations
-    class SeatTimer {
-    public:
-        bool is_running = false;
-        chrono::steady_clock::time_point start_time;
-        int getElapsedSeconds();
-    };
-    unordered_map<string, SeatTimer> seat_timers_;
-
     float calculateIoU(const Rect& rect1, const Rect& rect2);
-    string getISO8601Timestamp();
-    std::unordered_set<std::string> processed_files_;
+    void handleInput(JudgerInput& in);
+    // judge the lines appended to one JSONL file since its checkpoint; rows + checkpoint in one transaction
+    void tailJsonlFile(const string& jsonl_path);
+    TailCheckpoint& checkpointFor(const string& source);   // cached, loaded from DB on first use
+    // judge all seats of one frame and write results to DB
+    void judgeFrame(const vector<SeatObservation>& frame_obs);
+    // DB writes + log for one judged seat; true if the frame needs storing
+    bool writeSeatResult(const B2CD_State& state, const optional<B2C_SeatSnapshot>& snapshot,
+                         const optional<B2C_SeatEvent>& event, const vector<B2CD_Alert>& alerts);
+    void finishFrame(int frame_id, bool need_store_this_frame);
+    SeatStateTable& tableOf(SeatIdx idx);   // own table, or the owning shard's in sharded mode
+    void writeStateRows();                  // dirty seats -> judger_state; caller owns the transaction
+    bool stateCheckpointDue() const { return clock_ms_ - last_state_checkpoint_ms_ >= state_checkpoint_interval_ms_; }
+    // in-memory state as of a tail batch's BEGIN; put back when its transaction rolls back, so the
+    // re-read lines are judged once
+    struct TxnSnapshot {
+        SeatStateTable seats;   // gathered from the shards in sharded mode
+        size_t seat_count = 0;
+        AlertEngine alerts;
+        vector<uint8_t> seat_dirty;
+        vector<SeatIdx> dirty_seats;
+        unordered_set<int> stored_frames;
+        JudgerWriteStats write_stats;
+        int64_t clock_ms = 0;
+        int64_t last_alert_flush_ms = 0;
+        int64_t last_state_checkpoint_ms = 0;
+    };
+    void saveTxnSnapshot(TxnSnapshot& snap);   // no frames pending in the shards
+    void restoreTxnSnapshot(const TxnSnapshot& snap);
+    // advance the seat's pending transition; returns the confirmed status (on a confirmed change dwell_sec is
+    // set and since_ms is the candidate's first-seen ts, the change's event ts)
+    int debounceStatus(SeatIdx idx, int confirmed, int raw, int64_t ts_ms, int& dwell_sec, int64_t& since_ms);
+
+    JsonlTailReader tail_reader_;
+    unordered_map<string, TailCheckpoint> tail_checkpoints_;   // source (file name) -> committed position
+
+    JudgerDebounceConfig debounce_;
+    JudgerWriteStats write_stats_;
+    AlertEngineConfig alert_cfg_;
+    AlertEngine alert_engine_;
+    vector<AlertRecord> alert_rows_;   // reused by flushAlerts
+    int64_t last_alert_flush_ms_ = 0;
+
+    vector<uint8_t> seat_dirty_;   // judged since the last state checkpoint
+    vector<SeatIdx> dirty_seats_;
+    int64_t state_checkpoint_interval_ms_ = 10000;
+    int64_t last_state_checkpoint_ms_ = 0;
+    int64_t clock_ms_ = 0;
+
+    std::unique_ptr<ShardedJudger> sharded_;   // null = sequential
+    std::unique_ptr<SeatDbWriter> writer_;     // queue mode: group-commit writer for event / snapshot / alert rows
+    size_t shard_batch_frames_ = 64;
+
+    vector<SeatObservation> obs_buf_;   // reused per frame by processFrame / processFrameBatch
+    bool verbose_ = true;
 };
 
 #endif 
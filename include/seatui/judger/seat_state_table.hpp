@@ -0,0 +1,114 @@
+#ifndef SEAT_STATE_TABLE_HPP
+#define SEAT_STATE_TABLE_HPP
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// dense seat index, 0..SeatIdInterner::size()-1
+using SeatIdx = uint32_t;
+
+// maps external seat ids to dense indices once; the judger hot path then never hashes a string
+//   - vision path : integer seat_id               -> "S<id>"
+//   - JSONL path  : "12" / "S12" (normalized once) -> "S12"; other strings go through a map
+class SeatIdInterner {
+public:
+    SeatIdx intern(int seat_no) {
+        if (seat_no >= 0 && seat_no < kDirectRange) {
+            if (static_cast<size_t>(seat_no) >= by_number_.size()) by_number_.resize(seat_no + 1, kNone);
+            SeatIdx& slot = by_number_[seat_no];
+            if (slot == kNone) slot = add("S" + std::to_string(seat_no));
+            return slot;
+        }
+        return internName("S" + std::to_string(seat_no));
+    }
+
+    // same normalization as before: "" -> "S0", "S..." kept, otherwise "S" prefixed
+    SeatIdx intern(const std::string& raw) {
+        if (raw.empty()) return intern(0);
+        size_t p = raw[0] == 'S' ? 1 : 0;
+        int n = 0;
+        if (parseSeatNo(raw, p, n)) return intern(n);
+        return internName(p == 1 ? raw : "S" + raw);
+    }
+
+    const std::string& name(SeatIdx i) const { return names_[i]; }
+    size_t size() const { return names_.size(); }
+
+private:
+    static constexpr SeatIdx kNone = UINT32_MAX;
+    static constexpr int kDirectRange = 1 << 16;   // seat numbers below this use the flat lookup
+
+    // canonical decimal only ("012" keeps its own name, as the old normalizeSeatId did)
+    static bool parseSeatNo(const std::string& s, size_t p, int& out) {
+        if (p >= s.size() || s.size() - p > 9) return false;
+        if (s[p] == '0' && s.size() - p > 1) return false;
+        int v = 0;
+        for (size_t i = p; i < s.size(); ++i) {
+            if (s[i] < '0' || s[i] > '9') return false;
+            v = v * 10 + (s[i] - '0');
+        }
+        out = v;
+        return true;
+    }
+
+    SeatIdx internName(const std::string& name) {
+        auto it = by_name_.find(name);
+        if (it != by_name_.end()) return it->second;
+        SeatIdx idx = add(name);
+        by_name_.emplace(name, idx);
+        return idx;
+    }
+
+    SeatIdx add(std::string name) {
+        names_.push_back(std::move(name));
+        return static_cast<SeatIdx>(names_.size() - 1);
+    }
+
+    std::vector<SeatIdx> by_number_;                       // seat number -> index (kNone = unseen)
+    std::unordered_map<std::string, SeatIdx> by_name_;     // non-numeric / out-of-range ids
+    std::vector<std::string> names_;                       // index -> "S<id>"
+};
+
+// per-seat judger state, structure-of-arrays indexed by SeatIdx
+struct SeatStateTable {
+    std::vector<int64_t> last_ts_ms;          // ts of the last judged observation
+    std::vector<int32_t> status_duration;     // seconds in last_status
+    std::vector<int32_t> anomaly_duration;    // seconds of object-only occupancy
+    std::vector<int8_t>  last_status;         // B2CD_State::SeatStatus, -1 = never judged (confirmed status when debouncing)
+
+    // debounce: pending transition and heartbeat bookkeeping
+    std::vector<int8_t>  candidate_status;    // raw status waiting for its dwell, -1 = none
+    std::vector<int64_t> candidate_since_ms;
+    std::vector<int64_t> last_snapshot_ms;
+
+    size_t size() const { return last_status.size(); }
+
+    void ensure(SeatIdx idx) {
+        if (idx < last_status.size()) return;
+        size_t n = static_cast<size_t>(idx) + 1;
+        last_ts_ms.resize(n, 0);
+        status_duration.resize(n, 0);
+        anomaly_duration.resize(n, 0);
+        last_status.resize(n, -1);
+        candidate_status.resize(n, -1);
+        candidate_since_ms.resize(n, 0);
+        last_snapshot_ms.resize(n, 0);
+    }
+
+    // copy one seat's row (state moving between the judger and its shard judgers)
+    void copyRowFrom(const SeatStateTable& src, SeatIdx idx) {
+        if (idx >= src.size()) return;
+        ensure(idx);
+        last_ts_ms[idx] = src.last_ts_ms[idx];
+        status_duration[idx] = src.status_duration[idx];
+        anomaly_duration[idx] = src.anomaly_duration[idx];
+        last_status[idx] = src.last_status[idx];
+        candidate_status[idx] = src.candidate_status[idx];
+        candidate_since_ms[idx] = src.candidate_since_ms[idx];
+        last_snapshot_ms[idx] = src.last_snapshot_ms[idx];
+    }
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef SHARDED_JUDGER_HPP
+#define SHARDED_JUDGER_HPP
+#pragma once
+#include "data_structures.hpp"
+#include "seat_state_table.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+class SeatStateJudger;
+struct JudgerDebounceConfig;
+
+// one judged seat, as produced by a shard; (frame_seq, pos) is the deterministic merge key
+struct JudgedSeat {
+    uint32_t frame_seq = 0;    // index of the frame inside the current batch
+    uint32_t pos = 0;          // position of the seat inside its frame
+    B2CD_State state;
+    std::optional<B2C_SeatSnapshot> snapshot;
+    std::optional<B2C_SeatEvent> event;
+    std::vector<B2CD_Alert> alerts;
+};
+
+// sharded judging for large floors
+//   - seats are partitioned by a stable hash of the seat id (same seat -> same shard, across runs)
+//   - each shard owns a private SeatStateJudger (no DB, no locks) and a private output buffer
+//   - frames are batched by submit(); flush() lets every shard judge its seats of all pending
+//     frames in order (per-seat ordering preserved), then merges the buffers in (frame, seat
+//     position) order, i.e. exactly the order the sequential judger would have produced
+//   - the caller of flush() is the single writer that drains the merged records to the DB
+class ShardedJudger {
+public:
+    explicit ShardedJudger(int shards);
+    ~ShardedJudger();
+    ShardedJudger(const ShardedJudger&) = delete;
+    ShardedJudger& operator=(const ShardedJudger&) = delete;
+
+    static uint32_t shardOf(const std::string& seat_id, int shards);   // FNV-1a % shards
+
+    // queue one frame (observations carry the caller's seat_idx)
+    void submit(const std::vector<SeatObservation>& frame);
+
+    // judge all pending frames; returned records (owned by the shards) stay valid until the next submit()
+    const std::vector<const JudgedSeat*>& flush();
+
+    void setDebounce(const JudgerDebounceConfig& cfg);   // only between flushes
+
+    // state row of one seat lives in the table of the shard that owns it (only between flushes)
+    SeatStateTable& stateFor(SeatIdx idx, const std::string& seat_id);
+
+    size_t pendingFrames() const { return frame_sizes_.size(); }
+    int shardCount() const { return static_cast<int>(shards_.size()); }
+
+private:
+    struct WorkItem {
+        uint32_t frame_seq;
+        uint32_t pos;
+        SeatObservation obs;
+    };
+    struct Shard {
+        std::unique_ptr<SeatStateJudger> judger;
+        // both buffers only grow: slots (and their strings) are reused batch after batch
+        std::vector<WorkItem> work;       // filled by submit(), in frame order
+        size_t work_count = 0;
+        std::vector<JudgedSeat> out;      // filled by the shard thread, out[i] <-> work[i]
+        std::thread thread;
+    };
+
+    void shardLoop(size_t s);
+    void judgeShard(Shard& sh);
+    uint32_t shardFor(const SeatObservation& obs);
+    uint32_t shardFor(int32_t seat_idx, const std::string& seat_id);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<int16_t> shard_by_idx_;          // seat_idx -> shard, -1 = not computed yet
+    std::vector<uint32_t> frame_sizes_;          // per pending frame
+    std::vector<const JudgedSeat*> merged_;
+
+    // batch hand-off: generation bump wakes the shard threads, done_ counts finished shards
+    std::mutex mtx_;
+    std::condition_variable cv_work_;
+    std::condition_variable cv_done_;
+    uint64_t generation_ = 0;
+    size_t done_ = 0;
+    bool stop_ = false;
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "models.hpp"
 #include <QtCore/QObject>
+#include <QtGui/QImage>
 
 namespace seatui {
 
@@ -69,6 +69,38 @@ struct VisionConfig {
     // 是否仅使用一个多类检测模型；true 时跳过对象模型并行推理与合并
     bool use_single_multiclass_model = true;
 
+    // 多目标跟踪 (SORT/ByteTrack 风格): 跳过推理的帧由跟踪器预测框位置
+    bool  tracker_enable        = false;
+    int   detect_every_k_frames = 1;      // 每 K 帧运行一次检测器, 其余帧仅跟踪预测 (1 = 每帧检测)
+    float tracker_iou_match     = 0.30f;  // 轨迹与检测框关联 IoU 阈值
+    float tracker_high_conf     = 0.50f;  // 高分检测阈值 (低于此值的框只延续已有轨迹)
+    int   tracker_max_age       = 10;     // 轨迹最多连续多少帧未被检测命中
+    int   tracker_min_hits      = 2;      // 轨迹确认所需命中次数
+
+    // 占用判定后端: "yolo" = 整帧检测 + 座位归属; "seat_classifier" = 逐座位裁剪批量分类
+    std::string occupancy_backend   = "yolo";
+    std::string seat_cls_model_path = "assets/vision/weights/seat_cls.onnx";
+    int seat_cls_input_w = 64;              // 座位裁剪图缩放尺寸
+    int seat_cls_input_h = 64;
+    std::string seat_cls_output = "logits"; // 模型输出: "logits" (此处做 softmax) 或 "probs" (模型末层已是 softmax)
+
+    // 脏座位检测: 座位 ROI 缩略灰度图的 mean/std 与上次评估相比变化不超过阈值时沿用上次状态
+    bool  dirty_seat_enable         = false;
+    int   dirty_seat_thumb          = 16;     // ROI 缩放到 thumb x thumb 后计算签名
+    float dirty_seat_mean_delta     = 4.0f;   // 灰度均值变化阈值 (0~255)
+    float dirty_seat_std_delta      = 4.0f;   // 灰度标准差变化阈值
+    int   dirty_seat_refresh_frames = 30;     // 沿用超过 N 帧强制重新评估 (<=0 不强制)
+
+    // 近重复帧抑制: 与上一处理帧 dHash 汉明距离 <= 阈值时跳过整条流水线, 仅输出 "unchanged" 心跳记录
+    bool frame_dedup_enable   = false;
+    int  frame_dedup_hamming  = 4;        // 0~64, 越小越严格
+    int  frame_dedup_max_skip = 60;       // 连续抑制 N 帧后强制处理一帧 (<=0 不强制)
+
+    // 图像目录并行读入 (FrameProcessor::imageProcess): 0 = 串行 imread
+    int  ingest_workers        = 0;       // 解码线程数
+    int  ingest_max_in_flight  = 16;      // 已解码未处理的最大帧数 (重排缓冲上限)
+    bool ingest_reduced_decode = true;    // 原图远大于模型输入时使用 IMREAD_REDUCED_COLOR_2/4 解码
+
     // ===================== 方法methods ===================== //
 
     // 配置加载函数
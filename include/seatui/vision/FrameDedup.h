@@ -0,0 +1,44 @@
+#pragma once
+#include <opencv2/core.hpp>
+#include <cstdint>
+
+namespace vision {
+
+// 近重复帧抑制计数 (供外部查询/上报)
+struct FrameDedupStats {
+    int64_t frames_checked    = 0;   // 参与指纹比较的帧数
+    int64_t frames_suppressed = 0;   // 判定为近重复而跳过处理的帧数
+    int64_t last_processed_frame_index = -1;
+    int     last_distance     = -1;  // 最近一次比较的汉明距离 (-1 = 尚无参考帧)
+};
+
+/*  FrameDeduper 近重复帧抑制
+*
+*  - 指纹: 64 位 dHash (灰度缩放到 9x8, 比较水平相邻像素)
+*  - 与 "上一处理帧" 的指纹比较 (而非上一输入帧), 汉明距离 <= hamming_thres 视为近重复
+*  - 连续抑制 max_skip 帧后强制处理一帧, 保证背景模型与下游时长仍会刷新
+*/
+class FrameDeduper {
+public:
+    FrameDeduper(int hamming_thres, int max_skip)
+        : hamming_thres_(hamming_thres), max_skip_(max_skip) {}
+
+    // 返回 true 表示当前帧应跳过; 返回 false 时当前帧成为新的参考帧
+    bool isNearDuplicate(const cv::Mat& bgr, int64_t frame_index);
+
+    const FrameDedupStats& stats() const { return stats_; }
+    void reset() { has_ref_ = false; consecutive_skips_ = 0; }
+
+    static uint64_t dHash64(const cv::Mat& bgr);
+    static int hamming(uint64_t a, uint64_t b);
+
+private:
+    int hamming_thres_;
+    int max_skip_;
+    bool has_ref_ = false;
+    uint64_t ref_hash_ = 0;
+    int consecutive_skips_ = 0;
+    FrameDedupStats stats_;
+};
+
+} // namespace vision
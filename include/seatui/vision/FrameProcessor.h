@@ -167,6 +167,21 @@ public:
         int original_total_frames = 0
     );
 
+    /* @brief Parallel Image Processing 并行解码的批量图像处理 (cfg.ingest_workers > 0 时由 imageProcess 调用)
+    *  文件列表按文件名排序, N 个线程并行 imread, 重排缓冲保证按下标顺序交给 onFrame
+    *  参数与返回值同 imageProcess
+    */
+    static size_t imageProcessParallel(
+        const std::string& image_path,
+        const std::string& latest_frame_dir,
+        std::ofstream& ofs,
+        const VisionConfig& cfg,
+        VisionA& vision,
+        size_t max_process_frames = 500,
+        int sample_fp100 = 50,
+        int original_total_frames = 0
+    );
+
     // ==================== Utils: Sampling, Counting, Checking and Mapping ===========================
 
     // zero pad 6 digits
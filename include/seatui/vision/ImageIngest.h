@@ -0,0 +1,69 @@
+#pragma once
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vision {
+
+/*  ParallelImageReader 并行图像解码 + 有序输出
+*
+*  - 输入: 已排序的文件列表 (顺序即 frame_index 顺序)
+*  - N 个解码线程按下标领取文件并 imread, 结果放入重排缓冲
+*  - next() 严格按下标顺序返回, 保证下游 VisionA 收到的帧顺序与串行路径一致
+*  - 解码窗口受 max_in_flight 限制 (已领取但未被 next() 取走的帧数), 避免内存随目录大小增长
+*  - imread_flags 可为 IMREAD_REDUCED_COLOR_2/4; restore_size 非空时解码后 resize 回原尺寸,
+*    座位 ROI / 快照坐标仍按原图像素解释
+*/
+class ParallelImageReader {
+public:
+    ParallelImageReader(std::vector<std::filesystem::path> files,
+                        int workers,
+                        int max_in_flight = 16,
+                        int imread_flags = cv::IMREAD_COLOR,
+                        cv::Size restore_size = cv::Size());
+    ~ParallelImageReader();
+
+    ParallelImageReader(const ParallelImageReader&) = delete;
+    ParallelImageReader& operator=(const ParallelImageReader&) = delete;
+
+    // 取下一帧 (按下标顺序); 全部取完或已 stop() 时返回 false. 解码失败的帧 out 为空 Mat
+    bool next(size_t& index, cv::Mat& out);
+
+    // 提前终止 (例如达到 max_process_frames), 析构时也会调用
+    void stop();
+
+    size_t size() const { return files_.size(); }
+
+    // 目录下的 .jpg/.jpeg/.png 文件, 按文件名排序 (directory_iterator 顺序不确定)
+    static std::vector<std::filesystem::path> listImageFiles(const std::string& dir);
+
+    // 根据原图尺寸与模型输入尺寸选择降采样解码标志: 降采样后长边仍 >= target_long_side 才启用
+    static int chooseReducedFlag(cv::Size original, int target_long_side);
+
+private:
+    void workerLoop();
+
+    std::vector<std::filesystem::path> files_;
+    int max_in_flight_;
+    int imread_flags_;
+    cv::Size restore_size_;
+
+    std::mutex mtx_;
+    std::condition_variable cv_ready_;      // 重排缓冲有新帧
+    std::condition_variable cv_space_;      // 解码窗口有空位
+    std::map<size_t, cv::Mat> reorder_;
+    size_t next_out_ = 0;                   // 下一个要交付的下标
+    std::atomic<size_t> next_claim_{0};     // 下一个待领取解码的下标
+    bool stopped_ = false;
+
+    std::vector<std::thread> workers_;
+};
+
+} // namespace vision
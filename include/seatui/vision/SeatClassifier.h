@@ -0,0 +1,63 @@
+#pragma once
+#include "./third_party/onnxruntime/include/onnxruntime_cxx_api.h"
+#include <opencv2/opencv.hpp>
+#include <opencv2/core.hpp>
+#include <vector>
+#include <string>
+#include <memory>
+#include "Enums.h"
+
+namespace vision {
+
+    // 单个座位裁剪图的分类结果
+    struct SeatClsResult {
+        SeatOccupancyState state = SeatOccupancyState::UNKNOWN;
+        float conf = 0.f;       // argmax 类别的 softmax 概率
+        // UNKNOWN = 无结论 (推理失败 / 分类器未就绪 / 类别越界): 调用方沿用座位上次状态, 不当作空座
+    };
+
+    /*  OrtSeatClassifier 座位裁剪占用分类器
+    *
+    *   固定机位场景下每个座位只需判定 FREE / PERSON / OBJECT_ONLY，
+    *   用小分类模型替代整帧 640x640 YOLO：
+    *   - 输入: 所有座位 ROI 外接矩形裁剪图, 统一缩放到 input_w x input_h
+    *   - 一次 Session::Run 批量推理 [N,3,H,W]
+    *   - 输出: [N,C] logits 或概率 (SessionOptions::output_probs), 类别顺序与 SeatOccupancyState 一致
+    *     (0=FREE,1=PERSON,2=OBJECT_ONLY[,3=PERSON_AND_OBJECT])
+    */
+    class OrtSeatClassifier {
+    public:
+        struct SessionOptions {
+            std::string model_path = "assets/vision/weights/seat_cls.onnx";
+            int input_w = 64;
+            int input_h = 64;
+            int intra_threads = 0;    // 0 = auto
+            bool output_probs = false; // true: 模型输出已是概率 (含 softmax 层); false: logits, 此处做 softmax
+            bool fake_infer = false;
+        };
+
+        explicit OrtSeatClassifier(const SessionOptions& opt);
+        ~OrtSeatClassifier() = default;
+        bool isReady() const { return ready_; }
+
+        // crops: BGR 裁剪图 (任意尺寸), 返回与 crops 一一对应的分类结果; 推理失败的分块其座位为 UNKNOWN
+        std::vector<SeatClsResult> classify(const std::vector<cv::Mat>& crops);
+
+    private:
+        SessionOptions opt_;
+        bool ready_ = false;
+        int64_t model_batch_ = -1;               // 模型固定 batch (<=0 表示动态 batch)
+
+        Ort::Env env_;
+        Ort::SessionOptions session_options_;
+        std::unique_ptr<Ort::Session> session_;
+        std::string input_name_;
+        std::string output_name_;
+
+        std::vector<float> input_buf_;           // 复用的 NCHW 输入缓冲
+
+        void runBatch(const std::vector<cv::Mat>& crops, size_t begin, size_t count,
+                      std::vector<SeatClsResult>& out);
+    };
+
+} // namespace vision
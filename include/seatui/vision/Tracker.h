@@ -0,0 +1,68 @@
+#pragma once
+#include <opencv2/core.hpp>
+#include <opencv2/video/tracking.hpp>
+#include <vector>
+#include <string>
+#include "Types.h"
+
+namespace vision {
+
+// 多目标跟踪参数 (SORT / ByteTrack 风格)
+struct TrackerConfig {
+    float iou_match = 0.30f;   // 预测框与检测框关联的 IoU 阈值
+    float high_conf = 0.50f;   // 高分检测阈值: 高分框参与第一轮关联并可新建轨迹, 低分框只用于延续已有轨迹
+    int   max_age   = 10;      // 轨迹连续未被检测命中的最大帧数, 超过则删除
+    int   min_hits  = 2;       // 轨迹确认所需的最少命中次数, 确认后才在无检测帧输出预测框
+};
+
+/*  MultiObjectTracker 轻量多目标跟踪器
+*
+*  - 每条轨迹用常速度 Kalman 滤波器 (状态 [cx,cy,w,h,vx,vy,vw,vh]) 维护框位置
+*  - update(): 检测帧调用, 先预测再按 IoU 贪心关联 (同类别), 两轮关联: 高分框 -> 低分框
+*  - predict(): 跳过推理的帧调用, 仅做预测并输出已确认轨迹的预测框
+*  - 输出 BBox 的 track_id 在轨迹生命周期内保持不变
+*/
+class MultiObjectTracker {
+public:
+    explicit MultiObjectTracker(const TrackerConfig& cfg);
+    ~MultiObjectTracker() = default;
+
+    // 检测帧: 关联检测框并更新轨迹, 返回全部检测框 (已关联/新建的带 track_id, 未关联的低分框 track_id = -1)
+    std::vector<BBox> update(const std::vector<BBox>& detections);
+
+    // 无检测帧: 推进所有轨迹一步, 返回已确认且仍存活轨迹的预测框
+    std::vector<BBox> predict();
+
+    // 清空所有轨迹 (例如切换输入源时)
+    void reset();
+
+    size_t activeTrackCount() const { return tracks_.size(); }
+
+private:
+    struct Track {
+        int              track_id = -1;
+        int              cls_id = -1;
+        std::string      cls_name;
+        float            conf = 0.f;        // 最近一次命中的置信度
+        int              hits = 0;          // 累计命中次数
+        int              misses = 0;        // 连续未命中帧数
+        cv::KalmanFilter kf;
+        cv::Rect         rect;              // 当前 (预测或校正后) 的框
+    };
+
+    void initTrack(Track& t, const BBox& det);
+    cv::Rect stepPredict(Track& t);
+    void correct(Track& t, const BBox& det);
+    void prune();
+
+    // 贪心 IoU 关联: 返回 (track_idx, det_idx) 对
+    std::vector<std::pair<int, int>> associate(const std::vector<int>& track_idx,
+                                               const std::vector<int>& det_idx,
+                                               const std::vector<BBox>& detections) const;
+
+    TrackerConfig cfg_;
+    std::vector<Track> tracks_;
+    int next_id_ = 1;
+};
+
+} // namespace vision
@@ -13,6 +13,7 @@ struct BBox {
     float       conf = 0.f;     // 总置信度 (0~1)
     int         cls_id = -1;    // 类别 id (default = -1)
     std::string cls_name;       // 类别名称 ("person", "object", "backpack"...)
+    int         track_id = -1;  // 跟踪器分配的稳定 id (-1 = 未跟踪)
 };
 
 // 处理方法判据参考输入类型
@@ -48,6 +49,7 @@ struct SeatFrameState {
     std::vector<BBox> object_boxes_in_roi;
 
     std::string snapshot_path;     // 若本帧触发快照则非空
+    bool carried_forward = false;  // 状态沿用上次评估结果: 座位 ROI 未变化 (dirty_seat_enable) 或分类器无结论
 
     // 过程耗时 (ms) (performance metrics)
     int t_pre_ms  = 0;
@@ -55,6 +57,16 @@ struct SeatFrameState {
     int t_post_ms = 0;
 };
 
+// 近重复帧心跳记录: 不含 seats, 下游据 "unchanged" 沿用 ref_frame_index 对应帧的状态
+std::string frameHeartbeatToJsonLine(
+    int64_t ts_ms,
+    int64_t frame_index,
+    int64_t ref_frame_index,
+    const std::string& image_path,
+    int hamming_distance,
+    int64_t suppressed_total
+);
+
 // 返回单帧所有座位状态的 .json 字符串
 std::string seatFrameStatesToJson(const std::vector<SeatFrameState>& states);
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "Types.h"
 #include "Config.h"
+#include "FrameDedup.h"
 //#include "FrameProcessor.h"
 #include <opencv2/core.hpp>
 #include <memory>
@@ -20,11 +21,20 @@ public:
     // 获取上一帧的所有检测结果（人和物体）
     void getLastDetections(std::vector<BBox>& out_persons, std::vector<BBox>& out_objects) const;
 
-    void setPublisher(Publisher* p); // 不持有 not set yet
+    void setPublisher(Publisher* p); // 不持有; processFrame 结束时 publish 本帧所有座位状态
 
     // 新增: 返回座位数量，避免为了统计而进行一次推理
     int seatCount() const;
 
+    // 实际生效的占用后端: "seat_classifier" 或 "yolo" (分类器模型未就绪时回退为 yolo)
+    std::string occupancyBackend() const;
+
+    // 近重复帧抑制 (cfg.frame_dedup_enable): true 表示与上一处理帧几乎相同, 调用方应跳过 processFrame
+    bool isNearDuplicate(const cv::Mat& bgr, int64_t frame_index);
+    FrameDedupStats dedupStats() const;
+    // 被抑制的帧: 沿用上一处理帧的座位状态 (ts_ms / frame_index 换成本帧) 经 Publisher 推送, 下游在静止画面下仍按帧推进
+    std::vector<SeatFrameState> publishUnchanged(int64_t ts_ms, int64_t frame_index);
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
@@ -31,5 +31,11 @@ public:
     // now_t_ms
     int64_t now_ms();
 
+    // 进程内交接: 设置后每帧座位状态经 Publisher 直接推送 (如推入判定模块队列), 需在 runVision 前调用
+    void setPublishCallback(PublishCallback cb) { publish_cb_ = std::move(cb); }
+
+private:
+    PublishCallback publish_cb_;
+
 };
 }
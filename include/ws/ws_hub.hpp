@@ -25,6 +25,7 @@
 
 // 前置：数据库单例
 #include "../src/db_core/SeatDatabase.h"   // 按你的实际头文件路径
+#include <seatui/models.hpp>
 
 class WsHub : public QObject {
     Q_OBJECT
@@ -32,6 +33,10 @@ public:
     explicit WsHub(QObject* parent=nullptr);
     bool start(quint16 port, const QHostAddress& host = QHostAddress::LocalHost);
 
+public slots:
+    // 分区计数变化（DbSeatProvider::zoneUpdated）：立即推送 zone_update，不等定时器
+    void publishZone(const seatui::ZoneInfo& zone);
+
 signals:
     void started();
 
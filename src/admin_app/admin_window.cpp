@@ -19,12 +19,17 @@
 #include <QFrame>
 #include <QTimer>
 #include <QRandomGenerator>
+#include <QThread>
+#include <QPointer>
 
 #include <QtWebSockets/QWebSocketServer>
 #include <QtWebSockets/QWebSocket>
 
 #include <seatui/widgets/card_dialog.hpp>
 
+#include "../db_core/SeatDatabase.h"
+#include "../db_core/SeatDbBackup.h"
+
 // —— 前置声明：文件后面有它的实现（static自由函数）——
 static void upsertRow(QTableWidget* t, const QString& seat, int state,
                       const QString& sinceIso, const QString& recentIso);
@@ -150,6 +155,41 @@ QWidget* AdminWindow::buildOverviewPage() {
     auto t = new QLabel(QString::fromUtf8("这里展示关键 KPI（占位）：\n• 当前占用率\n• 今日异常数\n• 最近 1h 求助…"), w);
     t->setStyleSheet("font-size:15px; color:#334155;");
     v->addWidget(t);
+
+    // 数据库在线备份：后台线程跑 SeatDbBackup，写入不中断；结果回到 UI 线程显示
+    auto backupRow = new QHBoxLayout();
+    auto backupBtn = new QPushButton(QString::fromUtf8("立即备份数据库"), w);
+    auto backupStatus = new QLabel(w);
+    backupStatus->setStyleSheet("color:#64748b;");
+    backupRow->addWidget(backupBtn);
+    backupRow->addWidget(backupStatus, 1);
+    v->addLayout(backupRow);
+
+    connect(backupBtn, &QPushButton::clicked, this, [backupBtn, backupStatus]{
+        backupBtn->setEnabled(false);
+        backupStatus->setText(QString::fromUtf8("备份中…"));
+        QPointer<QPushButton> btn(backupBtn);
+        QPointer<QLabel> status(backupStatus);
+        auto worker = QThread::create([btn, status]{
+            const SeatDbBackupResult r = SeatDbBackup(SeatDatabase::getInstance()).run();
+            const QString text = r.ok
+                ? QString::fromUtf8("已备份到 %1（%2 MB，%3 s，%4 MB/s）")
+                      .arg(QString::fromStdString(r.path))
+                      .arg(r.bytes / (1024.0 * 1024.0), 0, 'f', 1)
+                      .arg(r.seconds, 0, 'f', 2)
+                      .arg(r.bytes_per_sec / (1024.0 * 1024.0), 0, 'f', 1)
+                : QString::fromUtf8("备份失败：%1").arg(QString::fromStdString(r.error));
+            if (status) {
+                QMetaObject::invokeMethod(status, [btn, status, text]{
+                    if (status) status->setText(text);
+                    if (btn) btn->setEnabled(true);
+                }, Qt::QueuedConnection);
+            }
+        });
+        connect(worker, &QThread::finished, worker, &QObject::deleteLater);
+        worker->start();
+    });
+
     v->addStretch();
     return w;
 }
@@ -19,7 +19,7 @@ public:
     
     // 数据更新方法
     bool insertSeatEvent(const QString& seatId, const QString& state, 
-                        const QString& timestamp, int durationSec = 0);
+                        qint64 tsMs, int durationSec = 0);
     
 signals:
     // 数据更新信号（供UI绑定）
@@ -1,6 +1,7 @@
 #ifndef DATA_TYPES_H
 #define DATA_TYPES_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -9,10 +10,12 @@
 struct SeatStatus {
     std::string seat_id;
     std::string state;  // "Seated", "Unseated", "Anomaly"
-    std::string last_update; // Standard timestamp format
+    int64_t last_update_ms; // epoch ms, formatted by the UI / WS edge
+    std::string zone;       // zones.name, empty = no zone
+    int roi_x = 0, roi_y = 0, roi_width = 0, roi_height = 0;   // seats.roi_* (getCurrentSeatStatus only)
     
-    SeatStatus(const std::string& id = "", const std::string& s = "Unseated", const std::string& update = "")
-        : seat_id(id), state(s), last_update(update) {}
+    SeatStatus(const std::string& id = "", const std::string& s = "Unseated", int64_t update_ms = 0)
+        : seat_id(id), state(s), last_update_ms(update_ms) {}
 };
 
 // B2CD_Alert corresponding to Module B
@@ -21,8 +24,11 @@ struct AlertData {
     std::string seat_id;
     std::string alert_type;  // "AnomalyOccupied"等
     std::string alert_desc;
-    std::string timestamp;
+    int64_t ts_ms;            // incident opened
     bool is_processed;
+    int64_t last_ts_ms = 0;   // condition last seen
+    int duration_sec = 0;
+    int64_t resolved_ts_ms = 0; // 0 = still open
 };
 
 // Corresponding B2C_SeatSnapshot of Module B
@@ -30,17 +36,29 @@ struct SeatSnapshot {
     std::string seat_id;
     std::string state;
     int person_count;
-    std::string timestamp;
+    int64_t ts_ms;
 };
 
 // Corresponding B2C_SeatEvent of Module B
 struct SeatEvent {
     std::string seat_id;
     std::string state;
-    std::string timestamp;
+    int64_t ts_ms;
     int duration_sec;
 };
 
+// Judger per-seat state checkpoint (judger_state table), restored on judger startup
+struct JudgerSeatState {
+    std::string seat_id;
+    int64_t last_ts_ms = 0;
+    int status_duration = 0;
+    int anomaly_duration = 0;
+    int last_status = -1;          // -1 = never judged
+    int candidate_status = -1;     // debounce: pending transition, -1 = none
+    int64_t candidate_since_ms = 0;
+    int64_t last_snapshot_ms = 0;
+};
+
 // Basic Statistical Information - Corresponding UI Display Requirements
 struct BasicStats {
     int total_seats;
@@ -51,6 +69,20 @@ struct BasicStats {
     BasicStats() : total_seats(0), occupied_seats(0), anomaly_seats(0), overall_occupancy_rate(0.0) {}
 };
 
+// Zone occupancy - counters kept by SeatDatabase on every seat state transition
+struct ZoneStatus {
+    int zone_id = -1;
+    std::string name;
+    int seat_total = 0;
+    int seat_occupied = 0;              // Seated / Anomaly
+    int roi_x = 0, roi_y = 0;           // bounding box of the zone's seat ROIs
+    int roi_width = 0, roi_height = 0;
+
+    double occupancyRatio() const {
+        return seat_total > 0 ? static_cast<double>(seat_occupied) / seat_total : 0.0;
+    }
+};
+
 // Hourly Data - For Trend Analysis
 struct HourlyData {
     std::string hour;
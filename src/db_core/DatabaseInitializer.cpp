@@ -1,6 +1,10 @@
 #include "DatabaseInitializer.h"
 #include "DatabaseSchemas.h"
 #include "TimeUtils.h"
+#include <json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
 #include <iostream>
 #include <vector>
 
@@ -40,9 +44,14 @@ bool DatabaseInitializer::clearExistingData() {
         database_.exec("DELETE FROM seat_agg_hourly");
         database_.exec("DELETE FROM seat_snapshots");
         database_.exec("DELETE FROM seat_events");
+        database_.exec("DELETE FROM seat_current");
+        database_.exec("DELETE FROM seat_intervals");
+        database_.exec("DELETE FROM retention_state");
         database_.exec("DELETE FROM seats");
+        database_.exec("DELETE FROM zones");
 
         database_.commitTransaction();
+        database_.reloadZones();
         return true;
 
     } catch (const std::exception& e) {
@@ -54,7 +63,7 @@ bool DatabaseInitializer::clearExistingData() {
 
 bool DatabaseInitializer::insertSampleSeats() {
     try {
-        // Quiet Study Area (quiet)
+        // no zone: zones come from the seat JSON (importSeatsFromJson)
         database_.insertSeat("S1", 177, 584, 225, 260);
         database_.insertSeat("S2", 428, 525, 225, 228);
         database_.insertSeat("S3", 272, 411, 167, 112);
@@ -70,11 +79,10 @@ bool DatabaseInitializer::insertSampleSeats() {
 
 bool DatabaseInitializer::insertSampleEvents() {
     try {
-        std::string current_time = TimeUtils::getCurrentTimestamp();
-        std::string one_hour_ago = TimeUtils::addHours(current_time, -1);
-        std::string two_hours_ago = TimeUtils::addHours(current_time, -2);
+        int64_t current_time = TimeUtils::nowMs();
+        // two_hours_ago = current_time - 2 * 3600 * 1000
 
-        
+        const std::vector<std::string> seat_ids = database_.getAllSeatIds();
         for (const auto& seat_id : seat_ids) {
             // Insert current state event (all seats are Unseated)
             database_.insertSeatEvent(seat_id, "Unseated", current_time, 0);
@@ -98,6 +106,64 @@ bool DatabaseInitializer::insertSampleEvents() {
     }
 }
 
+// {"seats": [{"seat_id", "roi": {x, y, w, h} or "poly": [[x, y], ...], "zone"}]}
+//   seat_id as the judger writes it: the number vision::loadSeatsFromJson takes ("A1" -> 1), "S" prefixed
+//   like SeatIdInterner ("S1")
+bool DatabaseInitializer::importSeatsFromJson(const std::string& path) {
+    std::ifstream ifs(path);
+    if (!ifs.is_open()) {
+        std::cerr << "Seat JSON not found: " << path << std::endl;
+        return false;
+    }
+    try {
+        nlohmann::json root;
+        ifs >> root;
+        int imported = 0;
+        for (const auto& s : root.value("seats", nlohmann::json::array())) {
+            std::string seat_id;
+            if (s.contains("seat_id") && s["seat_id"].is_number_integer()) {
+                seat_id = std::to_string(s["seat_id"].get<int>());
+            } else if (s.contains("seat_id") && s["seat_id"].is_string()) {
+                for (char c : s["seat_id"].get<std::string>()) {
+                    if (std::isdigit(static_cast<unsigned char>(c))) seat_id.push_back(c);
+                }
+                if (!seat_id.empty()) seat_id = std::to_string(std::stoi(seat_id));
+            }
+            if (seat_id.empty()) continue;
+            seat_id = "S" + seat_id;
+
+            int x = 0, y = 0, w = 0, h = 0;
+            if (s.contains("roi")) {
+                const auto& r = s["roi"];
+                x = r.value("x", 0);
+                y = r.value("y", 0);
+                w = r.value("w", 0);
+                h = r.value("h", 0);
+            } else if (s.contains("poly") && !s["poly"].empty()) {
+                // bounding box of the polygon
+                int x1 = 0, y1 = 0;
+                bool first = true;
+                for (const auto& p : s["poly"]) {
+                    const int px = p[0].get<int>(), py = p[1].get<int>();
+                    x = first ? px : std::min(x, px);
+                    y = first ? py : std::min(y, py);
+                    x1 = first ? px : std::max(x1, px);
+                    y1 = first ? py : std::max(y1, py);
+                    first = false;
+                }
+                w = x1 - x;
+                h = y1 - y;
+            }
+            if (database_.insertSeat(seat_id, x, y, w, h, s.value("zone", std::string()))) ++imported;
+        }
+        std::cout << "Imported " << imported << " seats from " << path << std::endl;
+        return imported > 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to import seats from " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
 bool DatabaseInitializer::exec(const std::string& sql) {
     try {
         database_.exec(sql);
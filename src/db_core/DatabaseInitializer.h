@@ -21,6 +21,9 @@ public:
     
     // Insert sample event
     bool insertSampleEvents();
+
+    // Seats (ROI, zone) from the vision seat JSON, e.g. assets/vision/config/demo_seats.json
+    bool importSeatsFromJson(const std::string& path);
     
 private:
     SeatDatabase& database_;
@@ -4,7 +4,23 @@
 #include <string>
 
 namespace DatabaseSchemas {
-    //Seat
+    //Connection settings (every connection; journal_mode = WAL is set once on the writer)
+    //  NORMAL is durable in WAL mode up to the last checkpointed commit, without an fsync per commit
+    const std::string CONNECTION_PRAGMAS = R"(
+        PRAGMA synchronous = NORMAL;
+        PRAGMA mmap_size = 268435456;
+        PRAGMA cache_size = -16384;
+        PRAGMA temp_store = MEMORY;
+        PRAGMA busy_timeout = 5000;
+    )";
+    //Zone (seat JSON "zone"), referenced by seats.zone_id
+    const std::string CREATE_ZONES_TABLE = R"(
+        CREATE TABLE IF NOT EXISTS zones (
+            zone_id INTEGER PRIMARY KEY AUTOINCREMENT,
+            name TEXT NOT NULL UNIQUE
+        );
+    )";
+    //Seat (zone_id NULL = not in a zone)
     const std::string CREATE_SEATS_TABLE = R"(
         CREATE TABLE IF NOT EXISTS seats (
             seat_id TEXT PRIMARY KEY,
@@ -12,7 +28,8 @@ namespace DatabaseSchemas {
             roi_y INTEGER NOT NULL,
             roi_width INTEGER NOT NULL,
             roi_height INTEGER NOT NULL,
-            created_at DATETIME DEFAULT CURRENT_TIMESTAMP
+            created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
+            zone_id INTEGER REFERENCES zones(zone_id)
         );
     )";
     //Seating incident
@@ -21,7 +38,7 @@ namespace DatabaseSchemas {
             event_id INTEGER PRIMARY KEY AUTOINCREMENT,
             seat_id TEXT NOT NULL,
             state TEXT NOT NULL CHECK(state IN ('Seated', 'Unseated', 'Anomaly')),
-            timestamp DATETIME NOT NULL,
+            ts_ms INTEGER NOT NULL,
             duration_sec INTEGER DEFAULT 0,
             FOREIGN KEY (seat_id) REFERENCES seats(seat_id)
         );
@@ -30,7 +47,7 @@ namespace DatabaseSchemas {
     const std::string CREATE_SEAT_SNAPSHOTS_TABLE = R"(
         CREATE TABLE IF NOT EXISTS seat_snapshots (
             snapshot_id INTEGER PRIMARY KEY AUTOINCREMENT,
-            timestamp DATETIME NOT NULL,
+            ts_ms INTEGER NOT NULL,
             seat_id TEXT NOT NULL,
             state TEXT NOT NULL,
             person_count INTEGER DEFAULT 0,
@@ -41,11 +58,12 @@ namespace DatabaseSchemas {
     const std::string CREATE_SEAT_AGG_HOURLY_TABLE = R"(
         CREATE TABLE IF NOT EXISTS seat_agg_hourly (
             agg_id INTEGER PRIMARY KEY AUTOINCREMENT,
-            date_hour DATETIME NOT NULL,
+            hour_ms INTEGER NOT NULL,
             seat_id TEXT NOT NULL,
             occupied_minutes INTEGER NOT NULL,
+            occupied_ms INTEGER NOT NULL DEFAULT 0,
             FOREIGN KEY (seat_id) REFERENCES seats(seat_id),
-            UNIQUE(date_hour, seat_id)
+            UNIQUE(hour_ms, seat_id)
         );
     )";
     //Alarm Table
@@ -55,12 +73,228 @@ namespace DatabaseSchemas {
             seat_id TEXT NOT NULL,
             alert_type TEXT NOT NULL,
             alert_desc TEXT NOT NULL,
-            timestamp TEXT NOT NULL,
+            ts_ms INTEGER NOT NULL,
+            last_ts_ms INTEGER NOT NULL DEFAULT 0,
+            duration_sec INTEGER NOT NULL DEFAULT 0,
+            resolved_ts_ms INTEGER NOT NULL DEFAULT 0,
             is_processed INTEGER DEFAULT 0,
             created_time TEXT DEFAULT CURRENT_TIMESTAMP,
             FOREIGN KEY (seat_id) REFERENCES seats(seat_id)
         )
     )";
+    //Ingest checkpoint: judger read position per JSONL file, committed with the judged rows
+    const std::string CREATE_INGEST_CHECKPOINTS_TABLE = R"(
+        CREATE TABLE IF NOT EXISTS ingest_checkpoints (
+            source TEXT PRIMARY KEY,
+            file_id INTEGER NOT NULL,
+            byte_offset INTEGER NOT NULL,
+            head_hash INTEGER NOT NULL DEFAULT 0,
+            updated_at DATETIME DEFAULT CURRENT_TIMESTAMP
+        );
+    )";
+    //Judger state checkpoint: one row per seat, written with the judged rows (O(seats) restart)
+    const std::string CREATE_JUDGER_STATE_TABLE = R"(
+        CREATE TABLE IF NOT EXISTS judger_state (
+            seat_id TEXT PRIMARY KEY,
+            last_ts_ms INTEGER NOT NULL,
+            status_duration INTEGER NOT NULL,
+            anomaly_duration INTEGER NOT NULL,
+            last_status INTEGER NOT NULL,
+            candidate_status INTEGER NOT NULL DEFAULT -1,
+            candidate_since_ms INTEGER NOT NULL DEFAULT 0,
+            last_snapshot_ms INTEGER NOT NULL DEFAULT 0
+        );
+    )";
+    //Retention progress (SeatDbRetention), e.g. how far seat_snapshots have been downsampled
+    const std::string CREATE_RETENTION_STATE_TABLE = R"(
+        CREATE TABLE IF NOT EXISTS retention_state (
+            name TEXT PRIMARY KEY,
+            value INTEGER NOT NULL
+        );
+    )";
+    //Current state per seat (latest seat_events row), kept by the trigger below
+    //  rollup_ms: the hourly rollup has folded this seat's current interval up to here
+    const std::string CREATE_SEAT_CURRENT_TABLE = R"(
+        CREATE TABLE IF NOT EXISTS seat_current (
+            seat_id TEXT PRIMARY KEY,
+            state TEXT NOT NULL,
+            ts_ms INTEGER NOT NULL,
+            duration_sec INTEGER DEFAULT 0,
+            rollup_ms INTEGER NOT NULL DEFAULT 0
+        );
+    )";
+    //  runs inside the statement that inserts the event, so it shares that row's transaction;
+    //  an older event arriving late does not overwrite a newer current state
+    const std::string CREATE_SEAT_CURRENT_TRIGGER = R"(
+        CREATE TRIGGER IF NOT EXISTS seat_events_to_current AFTER INSERT ON seat_events
+        BEGIN
+            INSERT INTO seat_current (seat_id, state, ts_ms, duration_sec)
+            VALUES (NEW.seat_id, NEW.state, NEW.ts_ms, NEW.duration_sec)
+            ON CONFLICT(seat_id) DO UPDATE SET
+                state = excluded.state,
+                ts_ms = excluded.ts_ms,
+                duration_sec = excluded.duration_sec
+            WHERE excluded.ts_ms >= seat_current.ts_ms;
+        END;
+    )";
+    //  databases that have events from before seat_current existed (bare columns come from the MAX row)
+    const std::string BACKFILL_SEAT_CURRENT = R"(
+        INSERT OR IGNORE INTO seat_current (seat_id, state, ts_ms, duration_sec)
+        SELECT seat_id, state, MAX(ts_ms), duration_sec FROM seat_events GROUP BY seat_id;
+    )";
+    //Seat state intervals: one row per run of the same state, [start_ms, end_ms); the open (current) run
+    //  has end_ms = INT64 max. A seat's intervals never overlap, so the one holding T is the first with
+    //  end_ms > T (one seek on (seat_id, end_ms)).
+    //  occupied_before_ms: the seat's occupied (Seated / Anomaly) time before start_ms, a running sum, so the
+    //  occupied time in [t0, t1) is two seeks per seat whatever the length of the range
+    //  last_event_ms: newest event folded into the run; on the open run it is the seat's newest event
+    const std::string CREATE_SEAT_INTERVALS_TABLE = R"(
+        CREATE TABLE IF NOT EXISTS seat_intervals (
+            interval_id INTEGER PRIMARY KEY AUTOINCREMENT,
+            seat_id TEXT NOT NULL,
+            state TEXT NOT NULL,
+            start_ms INTEGER NOT NULL,
+            end_ms INTEGER NOT NULL DEFAULT 9223372036854775807,
+            occupied_before_ms INTEGER NOT NULL DEFAULT 0,
+            last_event_ms INTEGER NOT NULL DEFAULT 0,
+            FOREIGN KEY (seat_id) REFERENCES seats(seat_id)
+        );
+    )";
+    //  closes the open interval and opens the next one when the state changes; repeats of the current
+    //  state extend it. Same late-event rule as seat_current: an event older than the seat's newest one
+    //  (the open run's last_event_ms) stays in seat_events only. Does not read seat_current, so the
+    //  order the two AFTER INSERT triggers fire in does not matter.
+    const std::string CREATE_SEAT_INTERVALS_TRIGGER = R"(
+        CREATE TRIGGER IF NOT EXISTS seat_events_to_intervals AFTER INSERT ON seat_events
+        WHEN NEW.ts_ms >= COALESCE((SELECT last_event_ms FROM seat_intervals
+                                    WHERE seat_id = NEW.seat_id AND end_ms = 9223372036854775807), NEW.ts_ms)
+        BEGIN
+            UPDATE seat_intervals SET last_event_ms = NEW.ts_ms
+            WHERE seat_id = NEW.seat_id AND end_ms = 9223372036854775807 AND state = NEW.state;
+            UPDATE seat_intervals SET end_ms = NEW.ts_ms
+            WHERE seat_id = NEW.seat_id AND end_ms = 9223372036854775807 AND state <> NEW.state;
+            INSERT INTO seat_intervals (seat_id, state, start_ms, occupied_before_ms, last_event_ms)
+            SELECT NEW.seat_id, NEW.state, NEW.ts_ms, COALESCE((
+                SELECT occupied_before_ms + CASE WHEN state IN ('Seated', 'Anomaly') THEN end_ms - start_ms ELSE 0 END
+                FROM seat_intervals WHERE seat_id = NEW.seat_id AND end_ms = NEW.ts_ms
+                ORDER BY start_ms DESC, interval_id DESC LIMIT 1), 0), NEW.ts_ms
+            WHERE NOT EXISTS (SELECT 1 FROM seat_intervals
+                              WHERE seat_id = NEW.seat_id AND end_ms = 9223372036854775807);
+        END;
+    )";
+    //Index plan v1 (epoch ms columns); replaces the first time-range indexes
+    const std::string INDEX_PLAN_V1 = R"(
+        DROP INDEX IF EXISTS idx_seat_events_seat_ts;
+        DROP INDEX IF EXISTS idx_seat_events_ts;
+        DROP INDEX IF EXISTS idx_alerts_processed_ts;
+        -- getOccupiedMinutes: one seat, time range, SUM(duration_sec) answered from the index
+        CREATE INDEX IF NOT EXISTS idx_seat_events_seat_ts_cover ON seat_events(seat_id, ts_ms, state, duration_sec);
+        -- getOverallOccupancyRate: time range, state filter and COUNT(DISTINCT seat_id) from the index
+        CREATE INDEX IF NOT EXISTS idx_seat_events_ts_state ON seat_events(ts_ms, state, seat_id);
+        -- time-range scans / retention
+        CREATE INDEX IF NOT EXISTS idx_seat_snapshots_ts ON seat_snapshots(ts_ms);
+        -- getUnprocessedAlerts / getOpenAlerts: partial, so they only hold the few rows still pending
+        CREATE INDEX IF NOT EXISTS idx_alerts_unprocessed_ts ON alerts(ts_ms) WHERE is_processed = 0;
+        CREATE INDEX IF NOT EXISTS idx_alerts_open_ts ON alerts(ts_ms) WHERE resolved_ts_ms = 0;
+    )";
+    //Hourly rollup v2: drop minute-only rows so the rollup is rebuilt from seat_events on start
+    const std::string RESET_HOURLY_ROLLUP = R"(
+        DELETE FROM seat_agg_hourly;
+        UPDATE seat_current SET rollup_ms = 0;
+    )";
+    //Interval store v3: overlap index, and intervals for the events already in the database
+    const std::string INTERVAL_PLAN_V3 = R"(
+        CREATE INDEX IF NOT EXISTS idx_seat_intervals_seat_end
+            ON seat_intervals(seat_id, end_ms, start_ms, state, occupied_before_ms);
+        DELETE FROM seat_intervals;
+        INSERT INTO seat_intervals (seat_id, state, start_ms, end_ms, occupied_before_ms)
+        SELECT seat_id, state, start_ms, end_ms,
+               COALESCE(SUM(CASE WHEN state IN ('Seated', 'Anomaly') THEN end_ms - start_ms ELSE 0 END)
+                        OVER (PARTITION BY seat_id ORDER BY start_ms, event_id
+                              ROWS BETWEEN UNBOUNDED PRECEDING AND 1 PRECEDING), 0)
+        FROM (SELECT event_id, seat_id, state, ts_ms AS start_ms,
+                     COALESCE(LEAD(ts_ms) OVER (PARTITION BY seat_id ORDER BY ts_ms, event_id),
+                              9223372036854775807) AS end_ms
+              FROM (SELECT event_id, seat_id, state, ts_ms,
+                           LAG(state) OVER (PARTITION BY seat_id ORDER BY ts_ms, event_id) AS prev_state
+                    FROM seat_events)
+              WHERE prev_state IS NULL OR prev_state <> state);
+    )";
+    //Interval store v4: late events follow the seat_current rule; the trigger is recreated by initialize()
+    //  events are taken in insertion order, one older than the seat's newest event so far is skipped;
+    //  runs of the same state are merged, last_event_ms = newest event of the run
+    const std::string INTERVAL_PLAN_V4 = R"(
+        DROP TRIGGER IF EXISTS seat_events_to_intervals;
+        DELETE FROM seat_intervals;
+        INSERT INTO seat_intervals (seat_id, state, start_ms, end_ms, occupied_before_ms, last_event_ms)
+        SELECT seat_id, state, start_ms, end_ms,
+               COALESCE(SUM(CASE WHEN state IN ('Seated', 'Anomaly') THEN end_ms - start_ms ELSE 0 END)
+                        OVER (PARTITION BY seat_id ORDER BY run
+                              ROWS BETWEEN UNBOUNDED PRECEDING AND 1 PRECEDING), 0),
+               last_event_ms
+        FROM (SELECT seat_id, run, state, start_ms, last_event_ms,
+                     COALESCE(LEAD(start_ms) OVER (PARTITION BY seat_id ORDER BY run),
+                              9223372036854775807) AS end_ms
+              FROM (SELECT seat_id, run, MIN(state) AS state, MIN(ts_ms) AS start_ms, MAX(ts_ms) AS last_event_ms
+                    FROM (SELECT seat_id, state, ts_ms,
+                                 SUM(changed) OVER (PARTITION BY seat_id ORDER BY event_id) AS run
+                          FROM (SELECT event_id, seat_id, state, ts_ms,
+                                       CASE WHEN LAG(state) OVER (PARTITION BY seat_id ORDER BY event_id) IS state
+                                            THEN 0 ELSE 1 END AS changed
+                                FROM (SELECT event_id, seat_id, state, ts_ms,
+                                             MAX(ts_ms) OVER (PARTITION BY seat_id ORDER BY event_id
+                                                              ROWS BETWEEN UNBOUNDED PRECEDING AND 1 PRECEDING) AS newest_ms
+                                      FROM seat_events)
+                                WHERE newest_ms IS NULL OR ts_ms >= newest_ms))
+                    GROUP BY seat_id, run));
+    )";
+    //Versioned schema steps: applied in order by SeatDatabase::createIndexes(), each in its own
+    //  transaction; PRAGMA user_version records the last one applied. Append only, never renumber.
+    struct SchemaVersion {
+        int version;
+        const char* description;
+        const std::string* sql;
+    };
+    const SchemaVersion SCHEMA_VERSIONS[] = {
+        {1, "index plan v1 (covering seat_events indexes, partial alert indexes)", &INDEX_PLAN_V1},
+        {2, "hourly rollup (rebuilt from seat_events)", &RESET_HOURLY_ROLLUP},
+        {3, "seat state intervals (backfilled from seat_events)", &INTERVAL_PLAN_V3},
+        {4, "seat state intervals: late events dropped as by seat_current", &INTERVAL_PLAN_V4},
+    };
+    //Migration: TEXT "YYYY-MM-DD HH:MM:SS" (local time) -> INTEGER epoch ms
+    //  the old table is renamed, rebuilt from its CREATE_* schema and its rows copied over
+    struct EpochMigration {
+        const char* table;
+        const char* old_column;
+        const char* new_column;
+        const char* kept_columns;     // copied as is
+        const std::string* create_sql;
+    };
+    const EpochMigration EPOCH_MS_MIGRATIONS[] = {
+        {"seat_events",     "timestamp", "ts_ms",   "event_id, seat_id, state, duration_sec", &CREATE_SEAT_EVENTS_TABLE},
+        {"seat_snapshots",  "timestamp", "ts_ms",   "snapshot_id, seat_id, state, person_count", &CREATE_SEAT_SNAPSHOTS_TABLE},
+        {"seat_agg_hourly", "date_hour", "hour_ms", "agg_id, seat_id, occupied_minutes", &CREATE_SEAT_AGG_HOURLY_TABLE},
+        {"alerts",          "timestamp", "ts_ms",   "alert_id, seat_id, alert_type, alert_desc, is_processed, created_time", &CREATE_ALERTS_TABLE},
+    };
+    //Columns added after a table was first released: {table, column, declaration}
+    struct AddedColumn {
+        const char* table;
+        const char* column;
+        const char* declaration;
+    };
+    const AddedColumn ADDED_COLUMNS[] = {
+        // alert incidents: one row per seat/type incident, updated in place
+        {"alerts", "last_ts_ms",     "INTEGER NOT NULL DEFAULT 0"},
+        {"alerts", "duration_sec",   "INTEGER NOT NULL DEFAULT 0"},
+        {"alerts", "resolved_ts_ms", "INTEGER NOT NULL DEFAULT 0"},
+        // hourly rollup: exact occupied time per bucket, and how far each seat has been folded
+        {"seat_agg_hourly", "occupied_ms", "INTEGER NOT NULL DEFAULT 0"},
+        {"seat_current",    "rollup_ms",   "INTEGER NOT NULL DEFAULT 0"},
+        // zones: seat membership
+        {"seats", "zone_id", "INTEGER REFERENCES zones(zone_id)"},
+        // interval store: newest event of the run (late-event rule)
+        {"seat_intervals", "last_event_ms", "INTEGER NOT NULL DEFAULT 0"},
+    };
 } // namespace DatabaseSchemas
 
 #endif // DATABASE_SCHEMAS_H
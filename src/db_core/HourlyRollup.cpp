@@ -0,0 +1,119 @@
+#include "HourlyRollup.h"
+#include <algorithm>
+
+void HourlyRollup::seed(const std::string& seat_id, const std::string& state, int64_t last_event_ms, int64_t since_ms) {
+    saveSeat(seat_id);
+    SeatCursor& c = seats_[seat_id];
+    c.occupied = isOccupied(state);
+    c.last_event_ms = last_event_ms;
+    c.since_ms = std::max(last_event_ms, since_ms);
+    advanceClock(c.since_ms);
+}
+
+void HourlyRollup::observe(const std::string& seat_id, const std::string& state, int64_t ts_ms) {
+    advanceClock(ts_ms);
+    auto it = seats_.find(seat_id);
+    if (it == seats_.end()) {
+        saveSeat(seat_id);
+        SeatCursor c;
+        c.occupied = isOccupied(state);
+        c.last_event_ms = ts_ms;
+        c.since_ms = ts_ms;
+        seats_.emplace(seat_id, c);
+        return;
+    }
+
+    SeatCursor& c = it->second;
+    if (ts_ms < c.last_event_ms) return;   // older than this seat's newest event: not a transition any more
+    saveSeat(seat_id);
+    if (c.occupied) {
+        if (ts_ms >= c.since_ms) {
+            fold(seat_id, c.since_ms, ts_ms, +1);
+        } else {
+            fold(seat_id, ts_ms, c.since_ms, -1);   // interval was folded up to the clock past this event
+        }
+    }
+    c.occupied = isOccupied(state);
+    c.last_event_ms = ts_ms;
+    c.since_ms = ts_ms;
+}
+
+void HourlyRollup::advanceClock(int64_t ts_ms) {
+    if (ts_ms <= clock_ms_) return;
+    if (clock_ms_ == 0) taken_ms_ = ts_ms;
+    clock_ms_ = ts_ms;
+}
+
+void HourlyRollup::takeChanges(std::vector<HourBucketDelta>& buckets,
+                               std::vector<std::pair<std::string, int64_t>>& cursors) {
+    buckets.clear();
+    cursors.clear();
+    for (auto& seat : seats_) {
+        SeatCursor& c = seat.second;
+        if (!c.occupied || c.since_ms >= clock_ms_) continue;
+        saveSeat(seat.first);
+        fold(seat.first, c.since_ms, clock_ms_, +1);
+        c.since_ms = clock_ms_;
+        cursors.emplace_back(seat.first, clock_ms_);
+    }
+
+    buckets.reserve(pending_.size());
+    for (const auto& p : pending_) {
+        if (undo_.recording) undo_.buckets.emplace_back(p.first, p.second);
+        if (p.second != 0) buckets.push_back({p.first.first, p.first.second, p.second});
+    }
+    pending_.clear();
+    taken_ms_ = clock_ms_;
+}
+
+void HourlyRollup::fold(const std::string& seat_id, int64_t from_ms, int64_t to_ms, int sign) {
+    while (from_ms < to_ms) {
+        const int64_t hour = hourOf(from_ms);
+        const int64_t end = std::min(to_ms, hour + kHourMs);
+        BucketKey key{hour, seat_id};
+        auto it = pending_.lower_bound(key);
+        if (it == pending_.end() || it->first != key) {
+            if (undo_.recording) undo_.buckets.emplace_back(key, std::nullopt);
+            it = pending_.emplace_hint(it, std::move(key), 0);
+        } else if (undo_.recording) {
+            undo_.buckets.emplace_back(key, it->second);
+        }
+        it->second += sign * (end - from_ms);
+        from_ms = end;
+    }
+}
+
+void HourlyRollup::saveSeat(const std::string& seat_id) {
+    if (!undo_.recording) return;
+    auto it = seats_.find(seat_id);
+    undo_.seats.emplace_back(seat_id, it == seats_.end() ? std::nullopt : std::optional<SeatCursor>(it->second));
+}
+
+void HourlyRollup::beginUndo() {
+    commitUndo();
+    undo_.recording = true;
+    undo_.clock_ms = clock_ms_;
+    undo_.taken_ms = taken_ms_;
+}
+
+void HourlyRollup::commitUndo() {
+    undo_.recording = false;
+    undo_.seats.clear();
+    undo_.buckets.clear();
+}
+
+// newest change first, so each seat / bucket ends at its value from before beginUndo()
+void HourlyRollup::rollbackUndo() {
+    if (!undo_.recording) return;
+    for (auto it = undo_.seats.rbegin(); it != undo_.seats.rend(); ++it) {
+        if (it->second) seats_[it->first] = *it->second;
+        else seats_.erase(it->first);
+    }
+    for (auto it = undo_.buckets.rbegin(); it != undo_.buckets.rend(); ++it) {
+        if (it->second) pending_[it->first] = *it->second;
+        else pending_.erase(it->first);
+    }
+    clock_ms_ = undo_.clock_ms;
+    taken_ms_ = undo_.taken_ms;
+    commitUndo();
+}
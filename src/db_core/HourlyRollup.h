@@ -0,0 +1,91 @@
+#ifndef HOURLY_ROLLUP_H
+#define HOURLY_ROLLUP_H
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// occupied time of one seat in one hour, as a delta to add to seat_agg_hourly
+struct HourBucketDelta {
+    int64_t hour_ms;         // start of the hour (epoch ms, hour-aligned)
+    std::string seat_id;
+    int64_t occupied_ms;     // may be negative: a transition arrived after its interval was folded
+};
+
+// Folds seat state transitions into per-seat, per-hour occupied time
+//   - a seat is occupied from a "Seated" / "Anomaly" event until its next event; the interval is split
+//     at hour boundaries into (hour, seat) buckets
+//   - the clock is the newest ts seen (events and snapshots), never the wall clock, so replays roll up
+//     exactly like live runs; open occupied intervals are folded up to the clock on takeChanges()
+//   - changes accumulate as deltas until takeChanges(); due() says when a batch is worth writing
+// Not thread-safe: SeatDatabase drives it under db_mutex_.
+class HourlyRollup {
+public:
+    static constexpr int64_t kHourMs = 3600 * 1000;
+
+    static bool isOccupied(const std::string& state) { return state == "Seated" || state == "Anomaly"; }
+    static int64_t hourOf(int64_t ts_ms) { return ts_ms - ((ts_ms % kHourMs) + kHourMs) % kHourMs; }
+
+    explicit HourlyRollup(size_t batch_buckets = 512, int64_t flush_interval_ms = 60 * 1000)
+        : batch_buckets_(batch_buckets), flush_interval_ms_(flush_interval_ms) {}
+
+    // state already rolled up to since_ms (restart: seat_current row and its rollup cursor)
+    void seed(const std::string& seat_id, const std::string& state, int64_t last_event_ms, int64_t since_ms);
+
+    void observe(const std::string& seat_id, const std::string& state, int64_t ts_ms);
+    void advanceClock(int64_t ts_ms);
+
+    // enough buckets pending, flush interval elapsed, or the clock crossed an hour since the last takeChanges()
+    bool due() const {
+        return pending_.size() >= batch_buckets_ || clock_ms_ - taken_ms_ >= flush_interval_ms_ ||
+               hourOf(clock_ms_) != hourOf(taken_ms_);
+    }
+
+    // fold open intervals up to the clock, then hand out the changed buckets and the seats whose
+    // rollup cursor moved (seat_id, cursor ms); both outputs are replaced
+    void takeChanges(std::vector<HourBucketDelta>& buckets, std::vector<std::pair<std::string, int64_t>>& cursors);
+
+    int64_t clockMs() const { return clock_ms_; }
+    size_t pendingBuckets() const { return pending_.size(); }
+
+    // undo log for a write transaction: from beginUndo() on, the prior value of every seat cursor and
+    // bucket that changes is recorded, so rollbackUndo() costs what the transaction changed, not the
+    // whole rollup. commitUndo() drops the log. One transaction at a time (SeatDatabase's writer lock)
+    void beginUndo();
+    void commitUndo();
+    void rollbackUndo();
+
+private:
+    struct SeatCursor {
+        bool occupied = false;
+        int64_t last_event_ms = 0;   // ts of the seat's newest event
+        int64_t since_ms = 0;        // occupied time is folded up to here
+    };
+
+    using BucketKey = std::pair<int64_t, std::string>;   // (hour, seat)
+
+    void fold(const std::string& seat_id, int64_t from_ms, int64_t to_ms, int sign);
+    void saveSeat(const std::string& seat_id);   // before seats_[seat_id] changes, while recording
+
+    size_t batch_buckets_;
+    int64_t flush_interval_ms_;
+    std::unordered_map<std::string, SeatCursor> seats_;
+    std::map<BucketKey, int64_t> pending_;   // (hour, seat) -> occupied ms delta
+    int64_t clock_ms_ = 0;
+    int64_t taken_ms_ = 0;   // clock at the last takeChanges()
+
+    struct UndoLog {
+        bool recording = false;
+        std::vector<std::pair<std::string, std::optional<SeatCursor>>> seats;   // nullopt = seat was new
+        std::vector<std::pair<BucketKey, std::optional<int64_t>>> buckets;     // nullopt = bucket was new
+        int64_t clock_ms = 0;
+        int64_t taken_ms = 0;
+    };
+    UndoLog undo_;
+};
+
+#endif // HOURLY_ROLLUP_H
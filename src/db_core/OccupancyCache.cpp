@@ -0,0 +1,195 @@
+#include "OccupancyCache.h"
+#include <algorithm>
+
+namespace {
+
+int64_t partitionOf(int64_t ts_ms) {
+    return ts_ms - ((ts_ms % OccupancyCache::kChunkMs) + OccupancyCache::kChunkMs) % OccupancyCache::kChunkMs;
+}
+
+// occupied overlap of runs [start[i], start[i + 1]) with [a, b), i < n (start holds n + 1 entries);
+// no branches in the body, so it compiles to vector min / max / compare. The runs of one chunk are
+// disjoint and inside one day, so the int32 sum cannot overflow
+int64_t occupiedOverlap(const int32_t* start, const uint8_t* state, size_t n, int32_t a, int32_t b) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const int32_t lo = start[i] > a ? start[i] : a;
+        const int32_t hi = start[i + 1] < b ? start[i + 1] : b;
+        const int32_t d = hi > lo ? hi - lo : 0;
+        sum += state[i] != 0 ? d : 0;
+    }
+    return sum;
+}
+
+// a bucket edge relative to a chunk, clamped to the chunk's day (all offsets lie inside it)
+int32_t offsetIn(int64_t begin_ms, int64_t ts_ms) {
+    return static_cast<int32_t>(std::min(std::max(ts_ms - begin_ms, int64_t{0}), OccupancyCache::kChunkMs));
+}
+
+} // namespace
+
+uint8_t OccupancyCache::stateCode(const std::string& state) {
+    if (state == "Seated") return 1;
+    if (state == "Anomaly") return 2;
+    return 0;
+}
+
+void OccupancyCache::clear() {
+    seats_.clear();
+    seat_ids_.clear();
+    index_.clear();
+    last_seat_ = 0;
+    runs_ = 0;
+}
+
+void OccupancyCache::append(const std::string& seat_id, const std::string& state, int64_t ts_ms,
+                            int64_t last_event_ms) {
+    if (last_seat_ >= seat_ids_.size() || seat_ids_[last_seat_] != seat_id) {
+        auto it = index_.find(seat_id);
+        if (it == index_.end()) {
+            it = index_.emplace(seat_id, seats_.size()).first;
+            seats_.emplace_back();
+            seat_ids_.push_back(seat_id);
+        }
+        last_seat_ = it->second;
+    }
+    Seat& seat = seats_[last_seat_];
+    if (ts_ms < seat.last_event_ms) return;   // late
+    seat.last_event_ms = std::max(ts_ms, last_event_ms);
+    const uint8_t code = stateCode(state);
+    const int64_t part = partitionOf(ts_ms);
+
+    if (!seat.chunks.empty()) {
+        Chunk& back = seat.chunks.back();
+        const int64_t last_start = back.begin_ms + back.offset_ms.back();
+        if (code == back.state.back()) return;
+        if (part == back.begin_ms) {
+            if (back.state.back() != 0) back.inner_ms += ts_ms - last_start;
+            back.offset_ms.push_back(static_cast<int32_t>(ts_ms - part));
+            back.state.push_back(code);
+            ++runs_;
+            return;
+        }
+    }
+    int64_t before_ms = 0;
+    if (!seat.chunks.empty()) {
+        const Chunk& back = seat.chunks.back();
+        before_ms = back.before_ms + back.inner_ms +
+                    (back.state.back() != 0 ? ts_ms - (back.begin_ms + back.offset_ms.back()) : 0);
+    }
+    seat.chunks.push_back(Chunk{part, {static_cast<int32_t>(ts_ms - part)}, {code}, 0, before_ms});
+    ++runs_;
+}
+
+void OccupancyCache::scanSeat(const Seat& seat, int64_t from_ms, int64_t bucket_ms, int buckets, int64_t clock_ms,
+                              int64_t* out) {
+    const int64_t end_ms = std::min(from_ms + bucket_ms * buckets, clock_ms);
+    if (seat.chunks.empty() || end_ms <= from_ms) return;
+
+    // the run holding from_ms: last chunk starting at or before it, then the last run in that chunk
+    auto first = std::upper_bound(seat.chunks.begin(), seat.chunks.end(), from_ms,
+                                  [](int64_t t, const Chunk& c) { return t < c.begin_ms + c.offset_ms.front(); });
+    size_t c = first == seat.chunks.begin() ? 0 : static_cast<size_t>(first - seat.chunks.begin()) - 1;
+    size_t i = 0;
+    if (seat.chunks[c].begin_ms + seat.chunks[c].offset_ms.front() <= from_ms) {
+        const auto& s = seat.chunks[c].offset_ms;
+        const int32_t from = offsetIn(seat.chunks[c].begin_ms, from_ms);
+        i = static_cast<size_t>(std::upper_bound(s.begin(), s.end(), from) - s.begin()) - 1;
+    }
+
+    auto firstMs = [](const Chunk& chunk) { return chunk.begin_ms + chunk.offset_ms.front(); };
+    int64_t k = 0;
+    while (c < seat.chunks.size()) {
+        const Chunk& chunk = seat.chunks[c];
+        const int32_t* start = chunk.offset_ms.data();
+        const uint8_t* state = chunk.state.data();
+        const size_t n = chunk.offset_ms.size();
+        // the chunk's last run ends where the next chunk starts
+        const int64_t last_end = c + 1 < seat.chunks.size() ? firstMs(seat.chunks[c + 1]) : clock_ms;
+        const int64_t last_start = chunk.begin_ms + start[n - 1];
+
+        if (i == 0 && firstMs(chunk) >= from_ms) {
+            if (firstMs(chunk) >= end_ms) return;
+            k = std::max(k, (firstMs(chunk) - from_ms) / bucket_ms);
+            const int64_t bucket_end = std::min(from_ms + (k + 1) * bucket_ms, end_ms);
+            if (last_end <= bucket_end && c + 1 < seat.chunks.size()) {
+                // chunks [c, c2) end inside the bucket: their occupied time from the running sums
+                auto next = std::upper_bound(seat.chunks.begin() + c + 1, seat.chunks.end(), bucket_end,
+                                             [&](int64_t t, const Chunk& ch) { return t < firstMs(ch); });
+                const size_t c2 = static_cast<size_t>(next - seat.chunks.begin()) - 1;
+                out[k] += seat.chunks[c2].before_ms - chunk.before_ms;
+                c = c2;
+                continue;
+            }
+        }
+
+        for (;;) {
+            const int64_t t = std::max(chunk.begin_ms + start[i], from_ms);
+            if (t >= end_ms) return;
+            k = std::max(k, (t - from_ms) / bucket_ms);
+            const int64_t bucket_begin = from_ms + k * bucket_ms;
+            const int64_t bucket_end = std::min(bucket_begin + bucket_ms, end_ms);
+
+            // runs [i, j) start inside the bucket (run i may start before it)
+            const int32_t b = offsetIn(chunk.begin_ms, bucket_end);
+            size_t j = i + 1;
+            while (j < n && start[j] < b) ++j;
+            int64_t sum = occupiedOverlap(start + i, state + i, std::min(j, n - 1) - i,
+                                          offsetIn(chunk.begin_ms, bucket_begin), b);
+            if (j == n && state[n - 1] != 0) {
+                sum += std::max<int64_t>(0, std::min(last_end, bucket_end) - std::max(last_start, bucket_begin));
+            }
+            out[k] += sum;
+
+            if (j == n && last_end <= bucket_end) break;   // rest of the seat is in the next chunk
+            if (bucket_end >= end_ms) return;
+            i = j - 1;   // the run crossing into the next bucket
+            ++k;
+        }
+        ++c;
+        i = 0;
+    }
+}
+
+void OccupancyCache::occupiedByBucket(int64_t from_ms, int64_t bucket_ms, int buckets, int64_t clock_ms,
+                                      const std::vector<int>& seat_group, int groups,
+                                      std::vector<int64_t>& out) const {
+    out.resize(static_cast<size_t>(groups) * buckets, 0);
+    if (bucket_ms <= 0 || buckets <= 0) return;
+    for (size_t s = 0; s < seats_.size(); ++s) {
+        int g = 0;
+        if (!seat_group.empty()) {
+            g = s < seat_group.size() ? seat_group[s] : -1;
+            if (g < 0 || g >= groups) continue;
+        }
+        scanSeat(seats_[s], from_ms, bucket_ms, buckets, clock_ms, out.data() + static_cast<size_t>(g) * buckets);
+    }
+}
+
+std::map<std::string, int64_t> OccupancyCache::occupiedPerSeat(int64_t start_ms, int64_t end_ms, int64_t clock_ms,
+                                                               const std::string& seat_id) const {
+    std::map<std::string, int64_t> occupied;
+    auto scan = [&](size_t s) {
+        int64_t ms = 0;
+        if (end_ms > start_ms) scanSeat(seats_[s], start_ms, end_ms - start_ms, 1, clock_ms, &ms);
+        occupied[seat_ids_[s]] = ms;
+    };
+    if (!seat_id.empty()) {
+        auto it = index_.find(seat_id);
+        if (it != index_.end()) scan(it->second);
+        return occupied;
+    }
+    for (size_t s = 0; s < seats_.size(); ++s) scan(s);
+    return occupied;
+}
+
+size_t OccupancyCache::bytes() const {
+    size_t total = seats_.capacity() * sizeof(Seat);
+    for (const Seat& seat : seats_) {
+        total += seat.chunks.capacity() * sizeof(Chunk);
+        for (const Chunk& chunk : seat.chunks) {
+            total += chunk.offset_ms.capacity() * sizeof(int32_t) + chunk.state.capacity();
+        }
+    }
+    return total;
+}
@@ -0,0 +1,69 @@
+#ifndef OCCUPANCY_CACHE_H
+#define OCCUPANCY_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Seat state runs kept in memory as columns, for the analytics queries
+//   - per seat: time-partitioned chunks (one UTC day each) holding the run start times and states (uint8);
+//     a run lasts until the seat's next run starts, the newest one up to the query's clock
+//   - start times are int32 ms offsets from the chunk start: the overlap loop then runs on 32-bit lanes,
+//     which SSE2 (the x64 baseline) can compare / min / max, unlike int64
+//   - occupied = Seated / Anomaly, the same runs as seat_intervals and the hourly rollup
+//   - a query scans the runs in its range with a branch-free overlap loop the compiler vectorizes; whole
+//     chunks inside one bucket come from a per-seat running sum instead
+// Not thread-safe: SeatDatabase drives it under its own mutex.
+class OccupancyCache {
+public:
+    static constexpr int64_t kChunkMs = 24LL * 3600 * 1000;
+
+    static uint8_t stateCode(const std::string& state);   // Unseated 0, Seated 1, Anomaly 2
+
+    void clear();
+
+    // seat_id is in `state` from ts_ms on. Like seat_current and the seat_intervals trigger, an event older
+    // than the seat's newest one, or in the current run's state, changes nothing. last_event_ms (>= ts_ms)
+    // is the newest event already folded into that run, when loading runs from seat_intervals
+    void append(const std::string& seat_id, const std::string& state, int64_t ts_ms, int64_t last_event_ms = 0);
+
+    // occupied ms per (group, bucket) over [from_ms, from_ms + buckets x bucket_ms), runs cut at clock_ms;
+    // out[g * buckets + k] is added to. seat_group[seat index] is the seat's group in [0, groups) or -1
+    // (skipped); an empty seat_group puts every seat in group 0
+    void occupiedByBucket(int64_t from_ms, int64_t bucket_ms, int buckets, int64_t clock_ms,
+                          const std::vector<int>& seat_group, int groups, std::vector<int64_t>& out) const;
+    // occupied ms in [start_ms, end_ms) per seat; one seat if seat_id is non-empty
+    std::map<std::string, int64_t> occupiedPerSeat(int64_t start_ms, int64_t end_ms, int64_t clock_ms,
+                                                   const std::string& seat_id = "") const;
+
+    const std::vector<std::string>& seatIds() const { return seat_ids_; }   // seat index order
+    size_t runCount() const { return runs_; }
+    size_t bytes() const;
+
+private:
+    struct Chunk {
+        int64_t begin_ms;                 // partition start, kChunkMs aligned
+        std::vector<int32_t> offset_ms;   // run start - begin_ms, sorted, never empty
+        std::vector<uint8_t> state;
+        int64_t inner_ms = 0;             // occupied ms of the runs but the last (it ends in a later chunk)
+        int64_t before_ms = 0;            // the seat's occupied ms before this chunk's first run
+    };
+    struct Seat {
+        std::vector<Chunk> chunks;        // by begin_ms
+        int64_t last_event_ms = INT64_MIN;   // newest event seen, late ones are dropped against it
+    };
+
+    // adds the seat's occupied ms of bucket k to out[k]
+    static void scanSeat(const Seat& seat, int64_t from_ms, int64_t bucket_ms, int buckets, int64_t clock_ms,
+                         int64_t* out);
+
+    std::vector<Seat> seats_;
+    std::vector<std::string> seat_ids_;
+    std::unordered_map<std::string, size_t> index_;
+    size_t last_seat_ = 0;   // append() is mostly called for the same seat in a row (load by seat)
+    size_t runs_ = 0;
+};
+
+#endif // OCCUPANCY_CACHE_H
@@ -5,17 +5,29 @@
 #include "TimeUtils.h"
 #include <iostream>
 #include <sstream>
+#include <cctype>
+#include <algorithm>
 
 SeatDatabase::SeatDatabase(const std::string& db_path) : db_path_(db_path) {
     try {
         database_ = std::make_unique<SQLite::Database>(db_path, SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
-        std::cout << "Database opened successfully: " << db_path << std::endl;
+        // only takes effect on a new (empty) file; lets SeatDbRetention hand freed pages back with incremental_vacuum
+        database_->exec("PRAGMA auto_vacuum = INCREMENTAL");
+        // WAL: readers keep a committed snapshot while the writer appends; ":memory:" stays in "memory" mode
+        std::string journal_mode = database_->execAndGet("PRAGMA journal_mode = WAL").getString();
+        database_->exec(DatabaseSchemas::CONNECTION_PRAGMAS);
+        std::cout << "Database opened successfully: " << db_path << " (journal_mode=" << journal_mode << ")" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Failed to open database: " << e.what() << std::endl;
         throw;
     }
 }
 
+SeatDatabase::~SeatDatabase() {
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
+    if (rollup_loaded_) flushRollup();   // keep the buckets folded since the last batch
+}
+
 // Singleton Pattern Implementation
 SeatDatabase& SeatDatabase::getInstance(const std::string& db_path) {
     static SeatDatabase instance(db_path);
@@ -23,12 +35,26 @@ SeatDatabase& SeatDatabase::getInstance(const std::string& db_path) {
 }
 
 bool SeatDatabase::initialize() {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
     try {
-        bool success = createTables();
+        bool success = createTables() && migrateTimestampsToEpochMs() && addMissingColumns() && createIndexes();
         if (success) {
+            // after the epoch migration: rebuilding seat_events drops the triggers on it
+            database_->exec(DatabaseSchemas::CREATE_SEAT_CURRENT_TRIGGER);
+            database_->exec(DatabaseSchemas::CREATE_SEAT_INTERVALS_TRIGGER);
+            if (database_->execAndGet("SELECT COUNT(*) FROM seat_current").getInt64() == 0) {
+                database_->exec(DatabaseSchemas::BACKFILL_SEAT_CURRENT);
+            }
+            success = loadHourlyRollup();
+            if (success) loadOccupancyCache();   // queries fall back to SQLite if this fails
+            if (success) loadZones();            // zone counters stay empty if this fails
             std::cout << "Database initialized successfully." << std::endl;
         }
+
+        // read pool only once the schema exists; a database that is not in WAL mode reads through the writer
+        std::lock_guard<std::mutex> pool_lock(pool_mutex_);
+        readers_enabled_ = success &&
+            database_->execAndGet("PRAGMA journal_mode").getString() == "wal";
         return success;
     } catch (const std::exception& e) {
         std::cerr << "Database initialization failed: " << e.what() << std::endl;
@@ -39,11 +65,17 @@ bool SeatDatabase::initialize() {
 // Create Table
 bool SeatDatabase::createTables() {
     try {
+        database_->exec(DatabaseSchemas::CREATE_ZONES_TABLE);
         database_->exec(DatabaseSchemas::CREATE_SEATS_TABLE);
         database_->exec(DatabaseSchemas::CREATE_SEAT_EVENTS_TABLE);
         database_->exec(DatabaseSchemas::CREATE_SEAT_SNAPSHOTS_TABLE);
         database_->exec(DatabaseSchemas::CREATE_SEAT_AGG_HOURLY_TABLE);
         database_->exec(DatabaseSchemas::CREATE_ALERTS_TABLE);
+        database_->exec(DatabaseSchemas::CREATE_INGEST_CHECKPOINTS_TABLE);
+        database_->exec(DatabaseSchemas::CREATE_JUDGER_STATE_TABLE);
+        database_->exec(DatabaseSchemas::CREATE_SEAT_CURRENT_TABLE);
+        database_->exec(DatabaseSchemas::CREATE_SEAT_INTERVALS_TABLE);
+        database_->exec(DatabaseSchemas::CREATE_RETENTION_STATE_TABLE);
         std::cout << "All tables created successfully." << std::endl;
         return true;
     } catch (const std::exception& e) {
@@ -52,23 +84,88 @@ bool SeatDatabase::createTables() {
     }
 }
 
+// Rebuild tables created before timestamps became epoch ms; no-op on current databases
+bool SeatDatabase::hasColumn(const std::string& table, const std::string& column) {
+    SQLite::Statement info(*database_, "PRAGMA table_info(" + table + ")");
+    while (info.executeStep()) {
+        if (info.getColumn(1).getString() == column) return true;
+    }
+    return false;
+}
+
+bool SeatDatabase::migrateTimestampsToEpochMs() {
+    try {
+        for (const auto& m : DatabaseSchemas::EPOCH_MS_MIGRATIONS) {
+            if (hasColumn(m.table, m.new_column) || !hasColumn(m.table, m.old_column)) continue;
+
+            const std::string table = m.table;
+            const std::string old_table = table + "_pre_epoch";
+            // stored strings are local time; unparsable values become 0 instead of failing NOT NULL
+            const std::string converted = std::string("COALESCE(CAST(strftime('%s', ") + m.old_column +
+                                          ", 'utc') AS INTEGER) * 1000, 0)";
+
+            SQLite::Transaction txn(*database_);
+            database_->exec("ALTER TABLE " + table + " RENAME TO " + old_table);
+            database_->exec(*m.create_sql);
+            database_->exec("INSERT INTO " + table + " (" + m.kept_columns + ", " + m.new_column + ") " +
+                            "SELECT " + m.kept_columns + ", " + converted + " FROM " + old_table);
+            database_->exec("DROP TABLE " + old_table);
+            txn.commit();
+            std::cout << "Migrated " << table << "." << m.old_column << " to epoch ms (" << m.new_column << ")" << std::endl;
+        }
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Timestamp migration failed: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Add columns introduced after a table's first release; no-op on current databases
+bool SeatDatabase::addMissingColumns() {
+    try {
+        for (const auto& c : DatabaseSchemas::ADDED_COLUMNS) {
+            if (hasColumn(c.table, c.column)) continue;
+            database_->exec(std::string("ALTER TABLE ") + c.table + " ADD COLUMN " + c.column + " " + c.declaration);
+            std::cout << "Added column " << c.table << "." << c.column << std::endl;
+        }
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Adding columns failed: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Apply the versioned schema steps newer than PRAGMA user_version (index plan and later changes)
+bool SeatDatabase::createIndexes() {
+    try {
+        int version = database_->execAndGet("PRAGMA user_version").getInt();
+        for (const auto& v : DatabaseSchemas::SCHEMA_VERSIONS) {
+            if (v.version <= version) continue;
+
+            SQLite::Transaction txn(*database_);
+            database_->exec(*v.sql);
+            database_->exec("PRAGMA user_version = " + std::to_string(v.version));
+            txn.commit();
+            version = v.version;
+            std::cout << "Schema version " << v.version << ": " << v.description << std::endl;
+        }
+        database_->exec("PRAGMA optimize");   // refresh planner statistics where they are stale
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Schema versioning failed: " << e.what() << std::endl;
+        return false;
+    }
+}
+
 // Insert Seat Event - Align with B2C_SeatEvent of Module B
 bool SeatDatabase::insertSeatEvent(const std::string& seat_id, 
                                   const std::string& state, 
-                                  const std::string& timestamp, 
+                                  int64_t ts_ms, 
                                   int duration_sec) {
 
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
     try {
-        SQLite::Statement query(*database_, 
-            "INSERT INTO seat_events (seat_id, state, timestamp, duration_sec) VALUES (?, ?, ?, ?)");
-        
-        query.bind(1, seat_id);
-        query.bind(2, state);
-        query.bind(3, timestamp);
-        query.bind(4, duration_sec);
-        
-        bool success = query.exec() == 1;
+        bool success = writeSeatEvent(seat_id, state, ts_ms, duration_sec);
         if (success) {
             std::cout << "Seat insertion event successful: " << seat_id << " " << state << std::endl;
         }
@@ -80,22 +177,14 @@ bool SeatDatabase::insertSeatEvent(const std::string& seat_id,
 }
 
 // Insert snapshot data - align with B module's B2C_SeatSnapshot
-bool SeatDatabase::insertSnapshot(const std::string& timestamp, 
+bool SeatDatabase::insertSnapshot(int64_t ts_ms, 
                                  const std::string& seat_id, 
                                  const std::string& state, 
                                  int person_count) {
 
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
     try {
-        SQLite::Statement query(*database_, 
-            "INSERT INTO seat_snapshots (timestamp, seat_id, state, person_count) VALUES (?, ?, ?, ?)");
-        
-        query.bind(1, timestamp);
-        query.bind(2, seat_id);
-        query.bind(3, state);
-        query.bind(4, person_count);
-        
-        return query.exec() == 1;
+        return writeSnapshot(ts_ms, seat_id, state, person_count);
     } catch (const std::exception& e) {
         std::cerr << "Insert snapshot failed: " << e.what() << std::endl;
         return false;
@@ -103,19 +192,12 @@ bool SeatDatabase::insertSnapshot(const std::string& timestamp,
 }
 
 // Insert hourly aggregated data
-bool SeatDatabase::insertHourlyAggregation(const std::string& date_hour, 
+bool SeatDatabase::insertHourlyAggregation(int64_t hour_ms, 
                                           const std::string& seat_id, 
                                           int occupied_minutes) {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
     try {
-        SQLite::Statement query(*database_, 
-            "INSERT OR REPLACE INTO seat_agg_hourly (date_hour, seat_id, occupied_minutes) VALUES (?, ?, ?)");
-        
-        query.bind(1, date_hour);
-        query.bind(2, seat_id);
-        query.bind(3, occupied_minutes);
-        
-        return query.exec() == 1;
+        return writeHourlyAggregation(hour_ms, seat_id, occupied_minutes);
     } catch (const std::exception& e) {
         std::cerr << "Insert hourly aggregation failed: " << e.what() << std::endl;
         return false;
@@ -124,19 +206,39 @@ bool SeatDatabase::insertHourlyAggregation(const std::string& date_hour,
 
 bool SeatDatabase::insertSeat(const std::string& seat_id, 
                              int roi_x, int roi_y, 
-                             int roi_width, int roi_height) {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+                             int roi_width, int roi_height,
+                             const std::string& zone) {
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
     try {
-        SQLite::Statement query(*database_, 
-            "INSERT OR REPLACE INTO seats (seat_id, roi_x, roi_y, roi_width, roi_height) VALUES (?, ?, ?, ?, ?)");
+        int zone_id = -1;
+        if (!zone.empty()) {
+            SQLite::Statement add(*database_, "INSERT INTO zones (name) VALUES (?) ON CONFLICT(name) DO NOTHING");
+            add.bind(1, zone);
+            add.exec();
+            SQLite::Statement find(*database_, "SELECT zone_id FROM zones WHERE name = ?");
+            find.bind(1, zone);
+            if (find.executeStep()) zone_id = find.getColumn(0).getInt();
+        }
+
+        // upsert rather than REPLACE: re-importing the seat JSON keeps created_at
+        SQLite::Statement query(*database_, R"(
+            INSERT INTO seats (seat_id, roi_x, roi_y, roi_width, roi_height, zone_id) VALUES (?, ?, ?, ?, ?, ?)
+            ON CONFLICT(seat_id) DO UPDATE SET
+                roi_x = excluded.roi_x, roi_y = excluded.roi_y,
+                roi_width = excluded.roi_width, roi_height = excluded.roi_height,
+                zone_id = excluded.zone_id
+        )");
         
         query.bind(1, seat_id);
         query.bind(2, roi_x);
         query.bind(3, roi_y);
         query.bind(4, roi_width);
         query.bind(5, roi_height);
+        if (zone_id >= 0) query.bind(6, zone_id);   // else NULL
         
-        return query.exec() == 1;
+        if (query.exec() != 1) return false;
+        assignZone(seat_id, zone_id, zone, roi_x, roi_y, roi_width, roi_height);
+        return true;
     } catch (const std::exception& e) {
         std::cerr << "Insert seat failed: " << e.what() << std::endl;
         return false;
@@ -149,22 +251,12 @@ bool SeatDatabase::insertAlert(
     const std::string& seat_id,
     const std::string& alert_type,
     const std::string& alert_desc,
-    const std::string& timestamp,
+    int64_t ts_ms,
     bool is_processed) {
     
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
     try {
-        SQLite::Statement query(*database_,
-            "INSERT INTO alerts (alert_id, seat_id, alert_type, alert_desc, timestamp, is_processed) VALUES (?, ?, ?, ?, ?, ?)");
-        
-        query.bind(1, alert_id);
-        query.bind(2, seat_id);
-        query.bind(3, alert_type);
-        query.bind(4, alert_desc);
-        query.bind(5, timestamp);
-        query.bind(6, is_processed ? 1 : 0);
-        
-        bool success = query.exec() == 1;
+        bool success = writeAlert(alert_id, seat_id, alert_type, alert_desc, ts_ms, is_processed);
         if (success) {
             std::cout << "Alert inserted: " << alert_id << " for seat " << seat_id << std::endl;
         }
@@ -175,14 +267,126 @@ bool SeatDatabase::insertAlert(
     }
 }
 
+// Open / update / resolve one alert incident (same alert_id for its whole lifetime)
+bool SeatDatabase::upsertAlert(const std::string& alert_id,
+                               const std::string& seat_id,
+                               const std::string& alert_type,
+                               const std::string& alert_desc,
+                               int64_t opened_ts_ms,
+                               int64_t last_ts_ms,
+                               int duration_sec,
+                               int64_t resolved_ts_ms) {
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
+    try {
+        return writeAlertUpsert(alert_id, seat_id, alert_type, alert_desc,
+                                opened_ts_ms, last_ts_ms, duration_sec, resolved_ts_ms);
+    } catch (const std::exception& e) {
+        std::cerr << "Upsert alert failed: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// ---- row writers: cached prepared statements, caller holds db_mutex_, errors are thrown ----
+
+SQLite::Statement& SeatDatabase::cachedStatement(const std::string& sql) {
+    auto it = statements_.find(sql);
+    if (it == statements_.end()) {
+        it = statements_.emplace(sql, std::make_unique<SQLite::Statement>(*database_, sql)).first;
+    } else {
+        it->second->tryReset();   // a previous use may have thrown half-way
+        it->second->clearBindings();
+    }
+    return *it->second;
+}
+
+bool SeatDatabase::writeSeatEvent(const std::string& seat_id, const std::string& state,
+                                  int64_t ts_ms, int duration_sec) {
+    SQLite::Statement& query = cachedStatement(
+        "INSERT INTO seat_events (seat_id, state, ts_ms, duration_sec) VALUES (?, ?, ?, ?)");
+    query.bind(1, seat_id);
+    query.bind(2, state);
+    query.bind(3, ts_ms);
+    query.bind(4, duration_sec);
+    if (query.exec() != 1) return false;
+
+    rollup_.observe(seat_id, state, ts_ms);
+    if (rollup_loaded_ && rollup_.due()) flushRollup();
+    observeZone(seat_id, state, ts_ms);
+    return true;
+}
+
+bool SeatDatabase::writeSnapshot(int64_t ts_ms, const std::string& seat_id,
+                                 const std::string& state, int person_count) {
+    SQLite::Statement& query = cachedStatement(
+        "INSERT INTO seat_snapshots (ts_ms, seat_id, state, person_count) VALUES (?, ?, ?, ?)");
+    query.bind(1, ts_ms);
+    query.bind(2, seat_id);
+    query.bind(3, state);
+    query.bind(4, person_count);
+    if (query.exec() != 1) return false;
+
+    rollup_.advanceClock(ts_ms);   // heartbeats move the rollup clock while no seat changes state
+    if (rollup_loaded_ && rollup_.due()) flushRollup();
+    return true;
+}
+
+bool SeatDatabase::writeHourlyAggregation(int64_t hour_ms, const std::string& seat_id, int occupied_minutes) {
+    SQLite::Statement& query = cachedStatement(
+        "INSERT OR REPLACE INTO seat_agg_hourly (hour_ms, seat_id, occupied_minutes, occupied_ms) VALUES (?, ?, ?, ?)");
+    query.bind(1, hour_ms);
+    query.bind(2, seat_id);
+    query.bind(3, occupied_minutes);
+    query.bind(4, static_cast<int64_t>(occupied_minutes) * 60000);
+    return query.exec() == 1;
+}
+
+bool SeatDatabase::writeAlert(const std::string& alert_id, const std::string& seat_id,
+                              const std::string& alert_type, const std::string& alert_desc,
+                              int64_t ts_ms, bool is_processed) {
+    SQLite::Statement& query = cachedStatement(
+        "INSERT INTO alerts (alert_id, seat_id, alert_type, alert_desc, ts_ms, is_processed) VALUES (?, ?, ?, ?, ?, ?)");
+    query.bind(1, alert_id);
+    query.bind(2, seat_id);
+    query.bind(3, alert_type);
+    query.bind(4, alert_desc);
+    query.bind(5, ts_ms);
+    query.bind(6, is_processed ? 1 : 0);
+    return query.exec() == 1;
+}
+
+bool SeatDatabase::writeAlertUpsert(const std::string& alert_id, const std::string& seat_id,
+                                    const std::string& alert_type, const std::string& alert_desc,
+                                    int64_t opened_ts_ms, int64_t last_ts_ms,
+                                    int duration_sec, int64_t resolved_ts_ms) {
+    SQLite::Statement& query = cachedStatement(R"(
+            INSERT INTO alerts (alert_id, seat_id, alert_type, alert_desc, ts_ms, last_ts_ms, duration_sec, resolved_ts_ms)
+            VALUES (?, ?, ?, ?, ?, ?, ?, ?)
+            ON CONFLICT(alert_id) DO UPDATE SET
+                alert_desc = excluded.alert_desc,
+                last_ts_ms = excluded.last_ts_ms,
+                duration_sec = excluded.duration_sec,
+                resolved_ts_ms = excluded.resolved_ts_ms
+        )");
+    query.bind(1, alert_id);
+    query.bind(2, seat_id);
+    query.bind(3, alert_type);
+    query.bind(4, alert_desc);
+    query.bind(5, opened_ts_ms);
+    query.bind(6, last_ts_ms);
+    query.bind(7, duration_sec);
+    query.bind(8, resolved_ts_ms);
+    return query.exec() == 1;
+}
+
 // Get Unprocessed Alerts
 std::vector<AlertData> SeatDatabase::getUnprocessedAlerts() {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    ReaderLease reader(*this);
     std::vector<AlertData> alerts;
     
     try {
-        SQLite::Statement query(*database_,
-            "SELECT alert_id, seat_id, alert_type, alert_desc, timestamp, is_processed FROM alerts WHERE is_processed = 0 ORDER BY timestamp DESC");
+        SQLite::Statement query(reader.db(),
+            "SELECT alert_id, seat_id, alert_type, alert_desc, ts_ms, is_processed, last_ts_ms, duration_sec, resolved_ts_ms "
+            "FROM alerts WHERE is_processed = 0 ORDER BY ts_ms DESC");
         
         while (query.executeStep()) {
             AlertData alert;
@@ -190,8 +394,11 @@ std::vector<AlertData> SeatDatabase::getUnprocessedAlerts() {
             alert.seat_id = query.getColumn(1).getString();
             alert.alert_type = query.getColumn(2).getString();
             alert.alert_desc = query.getColumn(3).getString();
-            alert.timestamp = query.getColumn(4).getString();
+            alert.ts_ms = query.getColumn(4).getInt64();
             alert.is_processed = query.getColumn(5).getInt() != 0;
+            alert.last_ts_ms = query.getColumn(6).getInt64();
+            alert.duration_sec = query.getColumn(7).getInt();
+            alert.resolved_ts_ms = query.getColumn(8).getInt64();
             alerts.push_back(alert);
         }
     } catch (const std::exception& e) {
@@ -203,7 +410,7 @@ std::vector<AlertData> SeatDatabase::getUnprocessedAlerts() {
 
 // Mark alert as resolved
 bool SeatDatabase::markAlertAsProcessed(const std::string& alert_id) {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
     try {
         SQLite::Statement query(*database_,
             "UPDATE alerts SET is_processed = 1 WHERE alert_id = ?");
@@ -218,23 +425,28 @@ bool SeatDatabase::markAlertAsProcessed(const std::string& alert_id) {
 
 // Get current seat status
 std::vector<SeatStatus> SeatDatabase::getCurrentSeatStatus() {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    ReaderLease reader(*this);
     std::vector<SeatStatus> results;
     
     try {
-        SQLite::Statement query(*database_, R"(
-            SELECT s.seat_id, e.state, MAX(e.timestamp) as last_update
+        // seat_current holds one row per seat: O(seats), independent of the event history
+        SQLite::Statement query(reader.db(), R"(
+            SELECT s.seat_id, c.state, c.ts_ms, z.name, s.roi_x, s.roi_y, s.roi_width, s.roi_height
             FROM seats s
-            LEFT JOIN seat_events e ON s.seat_id = e.seat_id
-            WHERE e.timestamp = (SELECT MAX(timestamp) FROM seat_events WHERE seat_id = s.seat_id)
-            GROUP BY s.seat_id
+            JOIN seat_current c ON s.seat_id = c.seat_id
+            LEFT JOIN zones z ON z.zone_id = s.zone_id
         )");
         
         while (query.executeStep()) {
             SeatStatus status;
             status.seat_id = query.getColumn(0).getString();
             status.state = query.getColumn(1).getString();
-            status.last_update = query.getColumn(2).getString();
+            status.last_update_ms = query.getColumn(2).getInt64();
+            status.zone = query.getColumn(3).getString();   // "" for NULL
+            status.roi_x = query.getColumn(4).getInt();
+            status.roi_y = query.getColumn(5).getInt();
+            status.roi_width = query.getColumn(6).getInt();
+            status.roi_height = query.getColumn(7).getInt();
             results.push_back(status);
         }
     } catch (const std::exception& e) {
@@ -246,7 +458,7 @@ std::vector<SeatStatus> SeatDatabase::getCurrentSeatStatus() {
 
 // Get basic statistics
 BasicStats SeatDatabase::getCurrentBasicStats() {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    ReaderLease reader(*this);
     BasicStats stats;
     stats.total_seats = 0;
     stats.occupied_seats = 0;
@@ -255,20 +467,17 @@ BasicStats SeatDatabase::getCurrentBasicStats() {
     
     try {
         // Get total number of seats
-        SQLite::Statement totalQuery(*database_, "SELECT COUNT(*) FROM seats");
+        SQLite::Statement totalQuery(reader.db(), "SELECT COUNT(*) FROM seats");
         if (totalQuery.executeStep()) {
             stats.total_seats = totalQuery.getColumn(0).getInt();
         }
         
         // Get the number of currently occupied and abnormal seats
-        SQLite::Statement statusQuery(*database_, R"(
-            SELECT state, COUNT(*) 
-            FROM (
-                SELECT s.seat_id, e.state
-                FROM seats s
-                LEFT JOIN seat_events e ON s.seat_id = e.seat_id
-                WHERE e.timestamp = (SELECT MAX(timestamp) FROM seat_events WHERE seat_id = s.seat_id)
-            ) GROUP BY state
+        SQLite::Statement statusQuery(reader.db(), R"(
+            SELECT c.state, COUNT(*)
+            FROM seats s
+            JOIN seat_current c ON s.seat_id = c.seat_id
+            GROUP BY c.state
         )");
         
         while (statusQuery.executeStep()) {
@@ -295,26 +504,15 @@ BasicStats SeatDatabase::getCurrentBasicStats() {
 
 // Get occupied minutes
 int SeatDatabase::getOccupiedMinutes(const std::string& seat_id, 
-                                    const std::string& start_time, 
-                                    const std::string& end_time) {
+                                    int64_t start_ms, 
+                                    int64_t end_ms) {
 
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    ReaderLease reader(*this);
     try {
-        SQLite::Statement query(*database_, R"(
-            SELECT SUM(duration_sec) 
-            FROM seat_events 
-            WHERE seat_id = ? 
-            AND timestamp BETWEEN ? AND ?
-            AND state IN ('Seated', 'Anomaly')
-        )");
-        
-        query.bind(1, seat_id);
-        query.bind(2, start_time);
-        query.bind(3, end_time);
-        
-        if (query.executeStep()) {
-            int total_seconds = query.getColumn(0).getInt();
-            return total_seconds / 60; // Convert to minutes
+        auto occupied = occupiedMs(reader.db(), seat_id, start_ms, end_ms);
+        auto it = occupied.find(seat_id);
+        if (it != occupied.end()) {
+            return static_cast<int>(it->second / 60000); // Convert to minutes
         }
     } catch (const std::exception& e) {
         std::cerr << "Get occupied minutes failed: " << e.what() << std::endl;
@@ -323,6 +521,95 @@ int SeatDatabase::getOccupiedMinutes(const std::string& seat_id,
     return 0;
 }
 
+std::map<std::string, double> SeatDatabase::getOccupiedSeconds(int64_t start_ms, int64_t end_ms) {
+    std::map<std::string, double> seconds;
+    ReaderLease reader(*this);
+    try {
+        for (const auto& seat : occupiedMs(reader.db(), "", start_ms, end_ms)) {
+            seconds[seat.first] = seat.second / 1000.0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Get occupied seconds failed: " << e.what() << std::endl;
+    }
+    return seconds;
+}
+
+// State of every seat at ts_ms: per seat, the first interval ending after ts_ms (one index seek each)
+std::vector<SeatStatus> SeatDatabase::getSeatStatusAt(int64_t ts_ms) {
+    std::vector<SeatStatus> statuses;
+    ReaderLease reader(*this);
+    try {
+        SQLite::Statement query(reader.db(), R"(
+            SELECT s.seat_id, i.state, i.start_ms
+            FROM seat_current s
+            JOIN seat_intervals i ON i.interval_id = (
+                SELECT interval_id FROM seat_intervals
+                WHERE seat_id = s.seat_id AND end_ms > ?1
+                ORDER BY end_ms LIMIT 1)
+            WHERE i.start_ms <= ?1
+            ORDER BY s.seat_id
+        )");
+        query.bind(1, ts_ms);
+
+        while (query.executeStep()) {
+            statuses.emplace_back(query.getColumn(0).getString(),
+                                  query.getColumn(1).getString(),
+                                  query.getColumn(2).getInt64());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Get seat status at time failed: " << e.what() << std::endl;
+    }
+    return statuses;
+}
+
+// Occupied (Seated / Anomaly) time in [start_ms, end_ms) as the difference of the seat's running sum at both
+// edges; the current interval is clipped to the data clock
+std::map<std::string, int64_t> SeatDatabase::occupiedMs(SQLite::Database& conn, const std::string& seat_id,
+                                                        int64_t start_ms, int64_t end_ms) {
+    std::map<std::string, int64_t> occupied;
+    const int64_t clock_ms = dataClockMs(conn);
+    start_ms = std::min(start_ms, clock_ms);
+    end_ms = std::min(end_ms, clock_ms);
+    if (end_ms <= start_ms) return occupied;
+
+    {
+        std::lock_guard<std::mutex> lock(occupancy_mutex_);
+        if (catchUpOccupancy(conn)) return occupancy_.occupiedPerSeat(start_ms, end_ms, clock_ms, seat_id);
+    }
+
+    // occupied time before T = the interval holding T (first end_ms > T), plus its part before T
+    std::string sql = R"(
+        SELECT s.seat_id,
+            COALESCE((SELECT occupied_before_ms +
+                             CASE WHEN state IN ('Seated', 'Anomaly') THEN MAX(0, ?2 - start_ms) ELSE 0 END
+                      FROM seat_intervals WHERE seat_id = s.seat_id AND end_ms > ?2
+                      ORDER BY end_ms LIMIT 1), 0)
+          - COALESCE((SELECT occupied_before_ms +
+                             CASE WHEN state IN ('Seated', 'Anomaly') THEN MAX(0, ?1 - start_ms) ELSE 0 END
+                      FROM seat_intervals WHERE seat_id = s.seat_id AND end_ms > ?1
+                      ORDER BY end_ms LIMIT 1), 0)
+        FROM seat_current s
+    )";
+    if (!seat_id.empty()) sql += " WHERE s.seat_id = ?3";
+
+    SQLite::Statement query(conn, sql);
+    query.bind(1, start_ms);
+    query.bind(2, end_ms);
+    if (!seat_id.empty()) query.bind(3, seat_id);
+
+    while (query.executeStep()) {
+        occupied[query.getColumn(0).getString()] = query.getColumn(1).getInt64();
+    }
+    return occupied;
+}
+
+int64_t SeatDatabase::dataClockMs(SQLite::Database& conn) {
+    return conn.execAndGet(R"(
+        SELECT MAX(COALESCE((SELECT MAX(ts_ms) FROM seat_snapshots), 0),
+                   COALESCE((SELECT MAX(ts_ms) FROM seat_current), 0))
+    )").getInt64();
+}
+
 // Get today's hourly data
 std::vector<HourlyData> SeatDatabase::getTodayHourlyData() {
     std::vector<HourlyData> result;
@@ -344,55 +631,26 @@ std::vector<HourlyData> SeatDatabase::getTodayHourlyData() {
     return result;
 }
 
-// Overall Utilization Calculation
-double SeatDatabase::getOverallOccupancyRate(const std::string& date_hour) {
-    std::lock_guard<std::mutex> lock(db_mutex_);
-    
+// Overall Utilization Calculation (one hour, from the rollup)
+double SeatDatabase::getOverallOccupancyRate(int64_t hour_ms) {
+    ReaderLease reader(*this);
     try {
-        // Get the total number of seats for that hour
-        SQLite::Statement totalQuery(*database_, "SELECT COUNT(*) FROM seats");
-        int total_seats = 0;
-        if (totalQuery.executeStep()) {
-            total_seats = totalQuery.getColumn(0).getInt();
-        }
-        
-        if (total_seats == 0) return 0.0;
-        
-        // Get the number of occupied seats for that hour
-        SQLite::Statement occupiedQuery(*database_, R"(
-            SELECT COUNT(DISTINCT seat_id) 
-            FROM seat_events 
-            WHERE timestamp BETWEEN ? AND datetime(?, '+1 hour')
-            AND state IN ('Seated', 'Anomaly')
-        )");
-        
-        occupiedQuery.bind(1, date_hour);
-        occupiedQuery.bind(2, date_hour);
-        
-        int occupied_seats = 0;
-        if (occupiedQuery.executeStep()) {
-            occupied_seats = occupiedQuery.getColumn(0).getInt();
-        }
-        
-        return static_cast<double>(occupied_seats) / total_seats;
-        
+        std::vector<double> rates;
+        hourlyOccupancy(reader.db(), hour_ms, 1, rates);
+        return rates[0];
     } catch (const std::exception& e) {
         std::cerr << "Get overall occupancy rate failed: " << e.what() << std::endl;
         return 0.0;
     }
 }
 
-// Daily Hour Utilization Rate
+// Daily Hour Utilization Rate (24 hours, one rollup query)
 std::vector<double> SeatDatabase::getDailyHourlyOccupancy(const std::string& date) {
     std::vector<double> hourly_rates(24, 0.0);
-    
+    ReaderLease reader(*this);
     try {
-        for (int hour = 0; hour < 24; ++hour) {
-            std::string date_hour = date + " " + 
-                                  (hour < 10 ? "0" : "") + 
-                                  std::to_string(hour) + ":00:00";
-            hourly_rates[hour] = getOverallOccupancyRate(date_hour);
-        }
+        const int64_t day_ms = TimeUtils::toEpochMs(date + " 00:00:00");
+        hourlyOccupancy(reader.db(), day_ms, 24, hourly_rates);
     } catch (const std::exception& e) {
         std::cerr << "Get daily hourly occupancy failed: " << e.what() << std::endl;
     }
@@ -400,50 +658,668 @@ std::vector<double> SeatDatabase::getDailyHourlyOccupancy(const std::string& dat
     return hourly_rates;
 }
 
+// Zone Utilization (one hour): the seats' buckets summed per zone, membership from the zone counters
+std::map<std::string, double> SeatDatabase::getHourlyZoneOccupancy(const std::string& date_hour) {
+    std::map<std::string, double> rates;
+    std::vector<ZoneStatus> zones;
+    std::unordered_map<std::string, int> seat_zone;
+    {
+        std::lock_guard<std::mutex> lock(zone_mutex_);
+        zones = zones_;
+        for (const auto& seat : zone_seats_) {
+            if (seat.second.zone >= 0) seat_zone.emplace(seat.first, seat.second.zone);
+        }
+    }
+    if (zones.empty()) return rates;
 
-// Start transaction
-bool SeatDatabase::beginTransaction() {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    ReaderLease reader(*this);
+    try {
+        // "YYYY-MM-DD HH", with or without ":MM:SS"
+        const int64_t hour_ms = HourlyRollup::hourOf(TimeUtils::toEpochMs(date_hour.substr(0, 13) + ":00:00"));
+        const int64_t clock_ms = dataClockMs(reader.db());
+
+        std::vector<int64_t> occupied(zones.size(), 0);
+        bool cached = false;
+        {
+            std::lock_guard<std::mutex> lock(occupancy_mutex_);
+            if (catchUpOccupancy(reader.db())) {
+                const auto& ids = occupancy_.seatIds();
+                std::vector<int> group(ids.size(), -1);
+                for (size_t i = 0; i < ids.size(); ++i) {
+                    auto it = seat_zone.find(ids[i]);
+                    if (it != seat_zone.end()) group[i] = it->second;
+                }
+                occupancy_.occupiedByBucket(hour_ms, HourlyRollup::kHourMs, 1, clock_ms, group,
+                                            static_cast<int>(zones.size()), occupied);
+                cached = true;
+            }
+        }
+        if (!cached) {
+            SQLite::Statement query(reader.db(), "SELECT seat_id, occupied_ms FROM seat_agg_hourly WHERE hour_ms = ?");
+            query.bind(1, hour_ms);
+            while (query.executeStep()) {
+                auto it = seat_zone.find(query.getColumn(0).getString());
+                if (it != seat_zone.end()) occupied[it->second] += query.getColumn(1).getInt64();
+            }
+        }
+
+        int64_t span_ms = HourlyRollup::kHourMs;
+        if (clock_ms > hour_ms && clock_ms < hour_ms + HourlyRollup::kHourMs) span_ms = clock_ms - hour_ms;
+        for (size_t z = 0; z < zones.size(); ++z) {
+            const int seats = zones[z].seat_total;
+            rates[zones[z].name] = seats > 0
+                ? std::min(1.0, static_cast<double>(occupied[z]) / (static_cast<double>(seats) * span_ms))
+                : 0.0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Get hourly zone occupancy failed: " << e.what() << std::endl;
+    }
+    return rates;
+}
+
+// rates[i] = occupied seat-time of hour i / (seats x length of hour i); the hour holding clock_ms counts
+// only up to clock_ms. Buckets are epoch-hour aligned, i.e. local hours in whole-hour UTC offsets.
+void SeatDatabase::hourlyOccupancy(SQLite::Database& conn, int64_t from_hour_ms, int hours,
+                                   std::vector<double>& rates) {
+    rates.assign(hours, 0.0);
+    const int64_t clock_ms = dataClockMs(conn);   // also rows written by another process (judger)
+    SQLite::Statement totalQuery(conn, "SELECT COUNT(*) FROM seats");
+    int total_seats = 0;
+    if (totalQuery.executeStep()) {
+        total_seats = totalQuery.getColumn(0).getInt();
+    }
+    if (total_seats == 0) return;
+
+    auto rate = [&](int i, int64_t occupied_ms) {
+        const int64_t hour = from_hour_ms + i * HourlyRollup::kHourMs;
+        int64_t span_ms = HourlyRollup::kHourMs;
+        if (clock_ms > hour && clock_ms < hour + HourlyRollup::kHourMs) span_ms = clock_ms - hour;
+        rates[i] = std::min(1.0, static_cast<double>(occupied_ms) / (static_cast<double>(total_seats) * span_ms));
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(occupancy_mutex_);
+        if (catchUpOccupancy(conn)) {
+            std::vector<int64_t> occupied;
+            occupancy_.occupiedByBucket(from_hour_ms, HourlyRollup::kHourMs, hours, clock_ms, {}, 1, occupied);
+            for (int i = 0; i < hours; ++i) {
+                if (occupied[i] > 0) rate(i, occupied[i]);
+            }
+            return;
+        }
+    }
+
+    SQLite::Statement query(conn, R"(
+        SELECT hour_ms, SUM(occupied_ms)
+        FROM seat_agg_hourly
+        WHERE hour_ms >= ? AND hour_ms < ?
+        GROUP BY hour_ms
+    )");
+    const int64_t to_hour_ms = from_hour_ms + hours * HourlyRollup::kHourMs;
+    query.bind(1, from_hour_ms);
+    query.bind(2, to_hour_ms);
+
+    while (query.executeStep()) {
+        const int64_t hour = query.getColumn(0).getInt64();
+        const int64_t occupied_ms = query.getColumn(1).getInt64();
+        const int i = static_cast<int>((hour - from_hour_ms) / HourlyRollup::kHourMs);
+        if (i < 0 || i >= hours) continue;
+        rate(i, occupied_ms);
+    }
+}
+
+// ---- occupancy cache ----
+
+// Every seat's state runs from seat_intervals, plus the seat_events watermark, read in one snapshot
+void SeatDatabase::loadOccupancyCache() {
+    std::lock_guard<std::mutex> lock(occupancy_mutex_);
+    occupancy_loaded_ = false;
+    occupancy_.clear();
     try {
-        database_->exec("BEGIN TRANSACTION");
+        SQLite::Transaction txn(*database_);
+        occupancy_event_id_ = database_->execAndGet("SELECT COALESCE(MAX(event_id), 0) FROM seat_events").getInt64();
+        // last_event_ms seeds each seat's newest event, so catch-up drops late events the trigger dropped
+        SQLite::Statement runs(*database_, "SELECT seat_id, state, start_ms, last_event_ms FROM seat_intervals "
+                                           "ORDER BY seat_id, end_ms");
+        while (runs.executeStep()) {
+            occupancy_.append(runs.getColumn(0).getString(), runs.getColumn(1).getString(), runs.getColumn(2).getInt64(),
+                              runs.getColumn(3).getInt64());
+        }
+        txn.commit();
+        occupancy_loaded_ = true;
+        std::cout << "Occupancy cache loaded: " << occupancy_.runCount() << " runs, " << occupancy_.bytes()
+                  << " bytes" << std::endl;
+    } catch (const std::exception& e) {
+        occupancy_.clear();
+        std::cerr << "Load occupancy cache failed: " << e.what() << std::endl;
+    }
+}
+
+// seat_events committed since the last query, in insert order; append() drops the late ones as the trigger did
+bool SeatDatabase::catchUpOccupancy(SQLite::Database& conn) {
+    if (!occupancy_loaded_ || !occupancy_enabled_) return false;
+    SQLite::Statement events(conn, "SELECT event_id, seat_id, state, ts_ms FROM seat_events WHERE event_id > ? ORDER BY event_id");
+    events.bind(1, occupancy_event_id_);
+    while (events.executeStep()) {
+        occupancy_.append(events.getColumn(1).getString(), events.getColumn(2).getString(), events.getColumn(3).getInt64());
+        occupancy_event_id_ = events.getColumn(0).getInt64();
+    }
+    return true;
+}
+
+// ---- zones ----
+
+std::vector<ZoneStatus> SeatDatabase::getZoneStatus() {
+    std::lock_guard<std::mutex> lock(zone_mutex_);
+    return zones_;
+}
+
+void SeatDatabase::setZoneListener(std::function<void(const ZoneStatus&)> listener) {
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
+    zone_listener_ = std::move(listener);
+}
+
+bool SeatDatabase::reloadZones() {
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
+    return loadZones();
+}
+
+// zones, seat membership and each seat's current state; the writer lock keeps out in-process writes meanwhile
+bool SeatDatabase::loadZones() {
+    std::vector<ZoneStatus> loaded;
+    {
+        std::lock_guard<std::mutex> lock(zone_mutex_);
+        zones_.clear();
+        zone_seats_.clear();
+        try {
+            std::unordered_map<int, int> index;   // zone_id -> zones_ index
+            SQLite::Statement zones(*database_, "SELECT zone_id, name FROM zones ORDER BY zone_id");
+            while (zones.executeStep()) {
+                ZoneStatus zone;
+                zone.zone_id = zones.getColumn(0).getInt();
+                zone.name = zones.getColumn(1).getString();
+                index.emplace(zone.zone_id, static_cast<int>(zones_.size()));
+                zones_.push_back(zone);
+            }
+            SQLite::Statement seats(*database_, R"(
+                SELECT s.seat_id, s.zone_id, s.roi_x, s.roi_y, s.roi_width, s.roi_height, c.state, c.ts_ms
+                FROM seats s
+                LEFT JOIN seat_current c ON c.seat_id = s.seat_id
+            )");
+            while (seats.executeStep()) {
+                ZoneSeat seat;
+                if (!seats.getColumn(1).isNull()) {
+                    auto it = index.find(seats.getColumn(1).getInt());
+                    if (it != index.end()) seat.zone = it->second;
+                }
+                seat.roi_x = seats.getColumn(2).getInt();
+                seat.roi_y = seats.getColumn(3).getInt();
+                seat.roi_width = seats.getColumn(4).getInt();
+                seat.roi_height = seats.getColumn(5).getInt();
+                if (!seats.getColumn(6).isNull()) {
+                    seat.occupied = OccupancyCache::stateCode(seats.getColumn(6).getString()) != 0;
+                    seat.ts_ms = seats.getColumn(7).getInt64();
+                }
+                if (seat.zone >= 0) {
+                    ++zones_[seat.zone].seat_total;
+                    if (seat.occupied) ++zones_[seat.zone].seat_occupied;
+                }
+                zone_seats_[seats.getColumn(0).getString()] = seat;
+            }
+            for (size_t z = 0; z < zones_.size(); ++z) updateZoneBox(static_cast<int>(z));
+            loaded = zones_;
+            std::cout << "Zones loaded: " << zones_.size() << " zones, " << zone_seats_.size() << " seats" << std::endl;
+        } catch (const std::exception& e) {
+            zones_.clear();
+            zone_seats_.clear();
+            std::cerr << "Load zones failed: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    notifyZones(loaded);
+    return true;
+}
+
+// one event: a seat turning occupied / free moves its zone's counter (same rule as seat_current)
+void SeatDatabase::observeZone(const std::string& seat_id, const std::string& state, int64_t ts_ms) {
+    ZoneStatus changed;
+    {
+        std::lock_guard<std::mutex> lock(zone_mutex_);
+        ZoneSeat& seat = zone_seats_[seat_id];
+        if (ts_ms < seat.ts_ms) return;
+        seat.ts_ms = ts_ms;
+        const bool occupied = OccupancyCache::stateCode(state) != 0;
+        if (occupied == seat.occupied) return;
+        seat.occupied = occupied;
+        if (seat.zone < 0) return;
+        ZoneStatus& zone = zones_[seat.zone];
+        zone.seat_occupied += occupied ? 1 : -1;
+        changed = zone;
+    }
+    if (zone_listener_) zone_listener_(changed);
+}
+
+// insertSeat: the seat leaves its old zone (if any) and joins zone_id (-1 = none), keeping its state
+void SeatDatabase::assignZone(const std::string& seat_id, int zone_id, const std::string& zone,
+                              int roi_x, int roi_y, int roi_width, int roi_height) {
+    std::vector<ZoneStatus> changed;
+    {
+        std::lock_guard<std::mutex> lock(zone_mutex_);
+        int next = -1;
+        if (zone_id >= 0) {
+            for (size_t z = 0; z < zones_.size(); ++z) {
+                if (zones_[z].zone_id == zone_id) next = static_cast<int>(z);
+            }
+            if (next < 0) {
+                ZoneStatus added;
+                added.zone_id = zone_id;
+                added.name = zone;
+                next = static_cast<int>(zones_.size());
+                zones_.push_back(added);
+            }
+        }
+
+        ZoneSeat& seat = zone_seats_[seat_id];
+        const int prev = seat.zone;
+        if (prev >= 0) {
+            --zones_[prev].seat_total;
+            if (seat.occupied) --zones_[prev].seat_occupied;
+        }
+        seat.zone = next;
+        seat.roi_x = roi_x;
+        seat.roi_y = roi_y;
+        seat.roi_width = roi_width;
+        seat.roi_height = roi_height;
+        if (next >= 0) {
+            ++zones_[next].seat_total;
+            if (seat.occupied) ++zones_[next].seat_occupied;
+        }
+
+        if (prev >= 0) {
+            updateZoneBox(prev);
+            changed.push_back(zones_[prev]);
+        }
+        if (next >= 0 && next != prev) {
+            updateZoneBox(next);
+            changed.push_back(zones_[next]);
+        }
+    }
+    notifyZones(changed);
+}
+
+void SeatDatabase::notifyZones(const std::vector<ZoneStatus>& changed) {
+    if (!zone_listener_) return;
+    for (const auto& zone : changed) zone_listener_(zone);
+}
+
+// bounding box of the zone's seat ROIs; O(seats), only on membership changes
+void SeatDatabase::updateZoneBox(int zone) {
+    int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    bool any = false;
+    for (const auto& entry : zone_seats_) {
+        const ZoneSeat& seat = entry.second;
+        if (seat.zone != zone) continue;
+        if (!any) {
+            x0 = seat.roi_x;
+            y0 = seat.roi_y;
+            x1 = seat.roi_x + seat.roi_width;
+            y1 = seat.roi_y + seat.roi_height;
+            any = true;
+            continue;
+        }
+        x0 = std::min(x0, seat.roi_x);
+        y0 = std::min(y0, seat.roi_y);
+        x1 = std::max(x1, seat.roi_x + seat.roi_width);
+        y1 = std::max(y1, seat.roi_y + seat.roi_height);
+    }
+    ZoneStatus& status = zones_[zone];
+    status.roi_x = x0;
+    status.roi_y = y0;
+    status.roi_width = x1 - x0;
+    status.roi_height = y1 - y0;
+}
+
+// ---- hourly rollup ----
+
+// Rebuild seat_agg_hourly from the event history (empty rollup), or continue from seat_current's cursors
+bool SeatDatabase::loadHourlyRollup() {
+    if (rollup_loaded_) return true;
+    try {
+        const bool rollup_empty = database_->execAndGet("SELECT NOT EXISTS (SELECT 1 FROM seat_agg_hourly)").getInt() != 0;
+        const bool has_events = database_->execAndGet("SELECT EXISTS (SELECT 1 FROM seat_events)").getInt() != 0;
+        rollup_loaded_ = true;
+
+        if (rollup_empty && has_events) {
+            SQLite::Transaction txn(*database_);
+            SQLite::Statement events(*database_, "SELECT seat_id, state, ts_ms FROM seat_events ORDER BY ts_ms");
+            int64_t n = 0;
+            while (events.executeStep()) {
+                rollup_.observe(events.getColumn(0).getString(), events.getColumn(1).getString(),
+                                events.getColumn(2).getInt64());
+                ++n;
+                if (rollup_.pendingBuckets() >= 4096) flushRollup();
+            }
+            flushRollup();
+            txn.commit();
+            std::cout << "Rebuilt hourly rollup from " << n << " seat events" << std::endl;
+            return true;
+        }
+
+        SQLite::Statement seats(*database_, "SELECT seat_id, state, ts_ms, rollup_ms FROM seat_current");
+        while (seats.executeStep()) {
+            rollup_.seed(seats.getColumn(0).getString(), seats.getColumn(1).getString(),
+                         seats.getColumn(2).getInt64(), seats.getColumn(3).getInt64());
+        }
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "Begin transaction failed: " << e.what() << std::endl;
+        std::cerr << "Load hourly rollup failed: " << e.what() << std::endl;
         return false;
     }
 }
 
-// Commit transaction
-bool SeatDatabase::commitTransaction() {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+void SeatDatabase::flushRollup() {
+    rollup_.takeChanges(rollup_buckets_, rollup_cursors_);
+    if (rollup_buckets_.empty() && rollup_cursors_.empty()) return;
+
+    // savepoint: nests in the caller's transaction (group commit, judger tail) or stands alone
+    try {
+        database_->exec("SAVEPOINT hourly_rollup");
+        SQLite::Statement& bucket = cachedStatement(R"(
+            INSERT INTO seat_agg_hourly (hour_ms, seat_id, occupied_minutes, occupied_ms) VALUES (?, ?, ?, ?)
+            ON CONFLICT(hour_ms, seat_id) DO UPDATE SET
+                occupied_ms = occupied_ms + excluded.occupied_ms,
+                occupied_minutes = (occupied_ms + excluded.occupied_ms) / 60000
+        )");
+        for (const auto& b : rollup_buckets_) {
+            bucket.bind(1, b.hour_ms);
+            bucket.bind(2, b.seat_id);
+            bucket.bind(3, static_cast<int>(b.occupied_ms / 60000));
+            bucket.bind(4, b.occupied_ms);
+            bucket.exec();
+            bucket.reset();
+        }
+        SQLite::Statement& cursor = cachedStatement("UPDATE seat_current SET rollup_ms = ? WHERE seat_id = ?");
+        for (const auto& c : rollup_cursors_) {
+            cursor.bind(1, c.second);
+            cursor.bind(2, c.first);
+            cursor.exec();
+            cursor.reset();
+        }
+        database_->exec("RELEASE hourly_rollup");
+    } catch (const std::exception& e) {
+        database_->tryExec("ROLLBACK TO hourly_rollup");
+        database_->tryExec("RELEASE hourly_rollup");
+        std::cerr << "Hourly rollup flush failed (" << rollup_buckets_.size() << " buckets dropped): " << e.what() << std::endl;
+    }
+}
+
+bool SeatDatabase::flushHourlyRollup() {
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
+    flushRollup();
+    return true;
+}
+
+// Save the judger's read position for one JSONL file
+bool SeatDatabase::saveIngestCheckpoint(const std::string& source, int64_t file_id,
+                                        int64_t byte_offset, int64_t head_hash) {
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
+    try {
+        SQLite::Statement& query = cachedStatement(R"(
+            INSERT INTO ingest_checkpoints (source, file_id, byte_offset, head_hash, updated_at)
+            VALUES (?, ?, ?, ?, CURRENT_TIMESTAMP)
+            ON CONFLICT(source) DO UPDATE SET
+                file_id = excluded.file_id,
+                byte_offset = excluded.byte_offset,
+                head_hash = excluded.head_hash,
+                updated_at = excluded.updated_at
+        )");
+
+        query.bind(1, source);
+        query.bind(2, file_id);
+        query.bind(3, byte_offset);
+        query.bind(4, head_hash);
+        return query.exec() == 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Save ingest checkpoint failed: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Load the read position; false if the file has never been checkpointed
+bool SeatDatabase::loadIngestCheckpoint(const std::string& source, int64_t& file_id,
+                                        int64_t& byte_offset, int64_t& head_hash) {
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
+    try {
+        SQLite::Statement query(*database_,
+            "SELECT file_id, byte_offset, head_hash FROM ingest_checkpoints WHERE source = ?");
+
+        query.bind(1, source);
+        if (query.executeStep()) {
+            file_id = query.getColumn(0).getInt64();
+            byte_offset = query.getColumn(1).getInt64();
+            head_hash = query.getColumn(2).getInt64();
+            return true;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Load ingest checkpoint failed: " << e.what() << std::endl;
+    }
+    return false;
+}
+
+// Save judger state rows (only the seats that changed since the last checkpoint)
+bool SeatDatabase::saveJudgerState(const std::vector<JudgerSeatState>& rows) {
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
     try {
-        database_->exec("COMMIT");
+        SQLite::Statement& query = cachedStatement(R"(
+            INSERT OR REPLACE INTO judger_state
+                (seat_id, last_ts_ms, status_duration, anomaly_duration, last_status,
+                 candidate_status, candidate_since_ms, last_snapshot_ms)
+            VALUES (?, ?, ?, ?, ?, ?, ?, ?)
+        )");
+
+        for (const auto& r : rows) {
+            query.bind(1, r.seat_id);
+            query.bind(2, r.last_ts_ms);
+            query.bind(3, r.status_duration);
+            query.bind(4, r.anomaly_duration);
+            query.bind(5, r.last_status);
+            query.bind(6, r.candidate_status);
+            query.bind(7, r.candidate_since_ms);
+            query.bind(8, r.last_snapshot_ms);
+            query.exec();
+            query.reset();
+        }
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "Commit transaction failed: " << e.what() << std::endl;
+        std::cerr << "Save judger state failed: " << e.what() << std::endl;
         return false;
     }
 }
 
-// Rollback transaction
-bool SeatDatabase::rollbackTransaction() {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+// Load the latest judger state checkpoint
+std::vector<JudgerSeatState> SeatDatabase::loadJudgerState() {
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
+    std::vector<JudgerSeatState> rows;
+
+    try {
+        SQLite::Statement query(*database_, R"(
+            SELECT seat_id, last_ts_ms, status_duration, anomaly_duration, last_status,
+                   candidate_status, candidate_since_ms, last_snapshot_ms
+            FROM judger_state
+        )");
+
+        while (query.executeStep()) {
+            JudgerSeatState r;
+            r.seat_id = query.getColumn(0).getString();
+            r.last_ts_ms = query.getColumn(1).getInt64();
+            r.status_duration = query.getColumn(2).getInt();
+            r.anomaly_duration = query.getColumn(3).getInt();
+            r.last_status = query.getColumn(4).getInt();
+            r.candidate_status = query.getColumn(5).getInt();
+            r.candidate_since_ms = query.getColumn(6).getInt64();
+            r.last_snapshot_ms = query.getColumn(7).getInt64();
+            rows.push_back(r);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Load judger state failed: " << e.what() << std::endl;
+    }
+
+    return rows;
+}
+
+// Alerts still open (not resolved), oldest first
+std::vector<AlertData> SeatDatabase::getOpenAlerts() {
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
+    std::vector<AlertData> alerts;
+
     try {
-        database_->exec("ROLLBACK");
+        SQLite::Statement query(*database_,
+            "SELECT alert_id, seat_id, alert_type, alert_desc, ts_ms, is_processed, last_ts_ms, duration_sec, resolved_ts_ms "
+            "FROM alerts WHERE resolved_ts_ms = 0 ORDER BY ts_ms");
+
+        while (query.executeStep()) {
+            AlertData alert;
+            alert.alert_id = query.getColumn(0).getString();
+            alert.seat_id = query.getColumn(1).getString();
+            alert.alert_type = query.getColumn(2).getString();
+            alert.alert_desc = query.getColumn(3).getString();
+            alert.ts_ms = query.getColumn(4).getInt64();
+            alert.is_processed = query.getColumn(5).getInt() != 0;
+            alert.last_ts_ms = query.getColumn(6).getInt64();
+            alert.duration_sec = query.getColumn(7).getInt();
+            alert.resolved_ts_ms = query.getColumn(8).getInt64();
+            alerts.push_back(alert);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Get open alerts failed: " << e.what() << std::endl;
+    }
+
+    return alerts;
+}
+
+// ---- read pool ----
+
+SeatDatabase::ReaderLease::ReaderLease(SeatDatabase& db) : owner_(db) {
+    std::unique_lock<std::mutex> lock(db.pool_mutex_);
+    if (!db.readers_enabled_) {
+        lock.unlock();
+        writer_lock_ = std::unique_lock<std::recursive_mutex>(db.db_mutex_);
+        conn_ = db.database_.get();
+        return;
+    }
+    db.pool_cv_.wait(lock, [&] { return !db.idle_readers_.empty() || db.open_readers_ < kMaxReaders; });
+    if (!db.idle_readers_.empty()) {
+        pooled_ = std::move(db.idle_readers_.back());
+        db.idle_readers_.pop_back();
+    } else {
+        ++db.open_readers_;
+        lock.unlock();
+        try {
+            pooled_ = std::make_unique<SQLite::Database>(db.db_path_, SQLite::OPEN_READONLY);
+            pooled_->exec(DatabaseSchemas::CONNECTION_PRAGMAS);
+        } catch (const std::exception& e) {
+            std::cerr << "Open reader connection failed, reading through the writer: " << e.what() << std::endl;
+            pooled_.reset();
+            lock.lock();
+            --db.open_readers_;
+            db.pool_cv_.notify_one();
+            lock.unlock();
+            writer_lock_ = std::unique_lock<std::recursive_mutex>(db.db_mutex_);
+            conn_ = db.database_.get();
+            return;
+        }
+    }
+    conn_ = pooled_.get();
+}
+
+SeatDatabase::ReaderLease::~ReaderLease() {
+    if (!pooled_) return;
+    std::lock_guard<std::mutex> lock(owner_.pool_mutex_);
+    owner_.idle_readers_.push_back(std::move(pooled_));
+    owner_.pool_cv_.notify_one();
+}
+
+// ---- write transactions ----
+
+SeatDatabase::WriteTransaction::WriteTransaction(SeatDatabase& db)
+    : db_(db), lock_(db.db_mutex_) {
+    try {
+        db_.database_->exec("BEGIN TRANSACTION");
+        active_ = true;
+        db_.rollup_.beginUndo();   // only the seats / buckets this transaction changes are saved
+    } catch (const std::exception& e) {
+        std::cerr << "Begin transaction failed: " << e.what() << std::endl;
+    }
+}
+
+SeatDatabase::WriteTransaction::~WriteTransaction() {
+    rollback();
+}
+
+bool SeatDatabase::WriteTransaction::commit() {
+    if (!active_) return false;
+    try {
+        db_.database_->exec("COMMIT");
+        active_ = false;
+        db_.rollup_.commitUndo();
         return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Commit transaction failed: " << e.what() << std::endl;
+        rollback();
+        return false;
+    }
+}
+
+bool SeatDatabase::WriteTransaction::rollback() {
+    if (!active_) return false;
+    active_ = false;
+    // the rows observed since BEGIN are gone: a replay must count them again
+    db_.rollup_.rollbackUndo();
+    try {
+        db_.database_->exec("ROLLBACK");
     } catch (const std::exception& e) {
         std::cerr << "Rollback transaction failed: " << e.what() << std::endl;
+    }
+    db_.loadZones();   // counters back to the committed seat_current
+    return true;
+}
+
+// Start transaction
+bool SeatDatabase::beginTransaction() {
+    std::unique_lock<std::recursive_mutex> lock(db_mutex_);
+    if (open_txn_) {
+        std::cerr << "Begin transaction failed: a transaction is already open" << std::endl;
         return false;
     }
+    auto txn = std::make_unique<WriteTransaction>(*this);
+    if (!txn->active()) return false;
+    open_txn_ = std::move(txn);   // keeps db_mutex_ locked until commit / rollback
+    return true;
+}
+
+// Commit transaction
+bool SeatDatabase::commitTransaction() {
+    std::unique_lock<std::recursive_mutex> lock(db_mutex_);
+    if (!open_txn_) return false;
+    auto txn = std::move(open_txn_);
+    return txn->commit();
+}
+
+// Rollback transaction
+bool SeatDatabase::rollbackTransaction() {
+    std::unique_lock<std::recursive_mutex> lock(db_mutex_);
+    if (!open_txn_) return false;
+    auto txn = std::move(open_txn_);
+    return txn->rollback();
 }
 
 // Utility method
 std::vector<std::string> SeatDatabase::getAllSeatIds() {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    ReaderLease reader(*this);
     std::vector<std::string> seat_ids;
     
     try {
-        SQLite::Statement query(*database_, "SELECT seat_id FROM seats");
+        SQLite::Statement query(reader.db(), "SELECT seat_id FROM seats");
         
         while (query.executeStep()) {
             seat_ids.push_back(query.getColumn(0).getString());
@@ -455,6 +1331,26 @@ std::vector<std::string> SeatDatabase::getAllSeatIds() {
     return seat_ids;
 }
 
+int64_t SeatDatabase::countRows(const std::string& table) {
+    // table names cannot be bound, accept plain identifiers only
+    for (char c : table) {
+        if (!(isalnum(static_cast<unsigned char>(c)) || c == '_')) {
+            std::cerr << "Count rows failed: invalid table name " << table << std::endl;
+            return -1;
+        }
+    }
+    ReaderLease reader(*this);
+    try {
+        SQLite::Statement query(reader.db(), "SELECT COUNT(*) FROM " + table);
+        if (query.executeStep()) {
+            return query.getColumn(0).getInt64();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Count rows failed: " << e.what() << std::endl;
+    }
+    return -1;
+}
+
 std::string SeatDatabase::getCurrentTimestamp() {
     // Simple implementation, can also use TimeUtils
     time_t now = time(nullptr);
@@ -465,7 +1361,7 @@ std::string SeatDatabase::getCurrentTimestamp() {
 
 
 bool SeatDatabase::exec(const std::string& sql) {
-    std::lock_guard<std::mutex> lock(db_mutex_);
+    std::lock_guard<std::recursive_mutex> lock(db_mutex_);
     try {
         database_->exec(sql);
         return true;
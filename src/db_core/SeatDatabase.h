@@ -3,13 +3,20 @@
 
 //#include "SQLiteCpp/SQLiteCpp.h"
 #include "../../../third_party/sqlite/include/SQLiteCpp/SQLiteCpp.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
 
 #include "DataTypes.h"  // Includes shared data types
+#include "HourlyRollup.h"
+#include "OccupancyCache.h"
 
 class SeatDatabase {
 public:
@@ -23,51 +30,85 @@ public:
     // Database Initialization
     bool initialize();
     
-    // Insert operation
+    // Insert operation (all times are epoch milliseconds)
     bool insertSeatEvent(const std::string& seat_id, 
                         const std::string& state, // "Seated", "Unseated", "Anomaly"
-                        const std::string& timestamp, 
+                        int64_t ts_ms, 
                         int duration_sec = 0);
     
-    bool insertSnapshot(const std::string& timestamp, 
+    bool insertSnapshot(int64_t ts_ms, 
                        const std::string& seat_id, 
                        const std::string& state, 
                        int person_count = 0);
     
-    bool insertHourlyAggregation(const std::string& date_hour, 
+    bool insertHourlyAggregation(int64_t hour_ms, // start of the hour
                                 const std::string& seat_id, 
                                 int occupied_minutes);
     
-    // Basic Data Insertion
+    // Basic Data Insertion (zone: zones.name, created on first use; empty = no zone)
     bool insertSeat(const std::string& seat_id, 
                    int roi_x, int roi_y, 
-                   int roi_width, int roi_height);
+                   int roi_width, int roi_height,
+                   const std::string& zone = "");
     // Alarm Entry Interface
     bool insertAlert(
         const std::string& alert_id,
         const std::string& seat_id,
         const std::string& alert_type,
         const std::string& alert_desc,
-        const std::string& timestamp,
+        int64_t ts_ms,
         bool is_processed = false
     );
 
-    // Query operation
+    // Alert incident: inserted when opened, then updated in place (resolved_ts_ms = 0 while open)
+    bool upsertAlert(const std::string& alert_id,
+                     const std::string& seat_id,
+                     const std::string& alert_type,
+                     const std::string& alert_desc,
+                     int64_t opened_ts_ms,
+                     int64_t last_ts_ms,
+                     int duration_sec,
+                     int64_t resolved_ts_ms);
+
+    // Query operation ([start_ms, end_ms) / [hour_ms, hour_ms + 1h))
     int getOccupiedMinutes(const std::string& seat_id, 
-                          const std::string& start_time, 
-                          const std::string& end_time);
+                          int64_t start_ms, 
+                          int64_t end_ms);
+
+    // Interval store (seat_intervals): intervals are clipped exactly to the range; a seat's current
+    // interval runs up to the newest event / snapshot ts
+    std::map<std::string, double> getOccupiedSeconds(int64_t start_ms, int64_t end_ms);   // per seat, [start_ms, end_ms)
+    std::vector<SeatStatus> getSeatStatusAt(int64_t ts_ms);   // last_update_ms = start of the state run holding ts_ms
     
-    double getOverallOccupancyRate(const std::string& date_hour);
+    // occupied seat-time / (seats x hour) from seat_agg_hourly as last flushed by the writer; the hour in
+    // progress counts up to the newest event / snapshot ts
+    double getOverallOccupancyRate(int64_t hour_ms);
     
     // UI Data Interface
     std::vector<SeatStatus> getCurrentSeatStatus();
     BasicStats getCurrentBasicStats();
     std::vector<HourlyData> getTodayHourlyData();
+    // zone name -> occupied seat-time / (zone seats x hour) for "YYYY-MM-DD HH[:MM:SS]" (local hour)
     std::map<std::string, double> getHourlyZoneOccupancy(const std::string& date_hour);
-    std::vector<double> getDailyHourlyOccupancy(const std::string& date);
+    std::vector<double> getDailyHourlyOccupancy(const std::string& date); // "YYYY-MM-DD", local day, one rollup query
+
+    // write the rollup buckets changed since the last batch (normally batched by writeSeatEvent and
+    // flushed by SeatDbWriter when its queue runs empty)
+    bool flushHourlyRollup();
+
+    // the occupancy queries above read the in-memory OccupancyCache (on by default); off = SQLite only
+    void setOccupancyCacheEnabled(bool enabled) { occupancy_enabled_ = enabled; }
+
+    // Zones: seat / occupied counters kept in memory on every seat state transition, O(zones) to read
+    std::vector<ZoneStatus> getZoneStatus();
+    // called after each change of a zone's counters, on the writing thread with the writer lock held:
+    // may read getZoneStatus(), must not write; nullptr removes it
+    void setZoneListener(std::function<void(const ZoneStatus&)> listener);
+    bool reloadZones();   // after seats / zones / seat_current were changed with exec() (DatabaseInitializer)
     
     // Utility method
     std::vector<std::string> getAllSeatIds();
+    int64_t countRows(const std::string& table);   // -1 on error (e.g. unknown table)
     std::string getCurrentTimestamp();
 
      // Add exec method
@@ -79,21 +120,134 @@ public:
     // Mark alert as handled
     bool markAlertAsProcessed(const std::string& alert_id);
 
-    // Batch operation
+    // Ingest checkpoint (judger tailing reader); call inside the transaction that writes the judged rows
+    bool saveIngestCheckpoint(const std::string& source, int64_t file_id, int64_t byte_offset, int64_t head_hash);
+    bool loadIngestCheckpoint(const std::string& source, int64_t& file_id, int64_t& byte_offset, int64_t& head_hash);
+
+    // Judger state checkpoint (one row per seat); save inside the transaction that writes the judged rows
+    bool saveJudgerState(const std::vector<JudgerSeatState>& rows);
+    std::vector<JudgerSeatState> loadJudgerState();
+    std::vector<AlertData> getOpenAlerts();   // resolved_ts_ms = 0, for the judger's alert engine on restart
+
+    // Batch operation: holds the writer lock from BEGIN until it goes out of scope, so other threads'
+    // writes neither join the transaction nor fail on it; not committed = rolled back, and the
+    // in-memory rollup / zone counters are put back with the rows
+    class WriteTransaction {
+    public:
+        explicit WriteTransaction(SeatDatabase& db);
+        ~WriteTransaction();
+        WriteTransaction(const WriteTransaction&) = delete;
+        WriteTransaction& operator=(const WriteTransaction&) = delete;
+        bool active() const { return active_; }   // BEGIN succeeded, not yet committed / rolled back
+        bool commit();     // false = rolled back
+        bool rollback();
+    private:
+        SeatDatabase& db_;
+        std::unique_lock<std::recursive_mutex> lock_;
+        bool active_ = false;   // BEGIN done; the rollup records its undo log meanwhile
+    };
+
+    // same, for callers that cannot keep a scope open: the calling thread holds the writer lock until
+    // commitTransaction / rollbackTransaction
     bool beginTransaction();
     bool commitTransaction();
     bool rollbackTransaction();
 
 private:
     SeatDatabase(const std::string& db_path);
-    ~SeatDatabase() = default;
+    ~SeatDatabase();
     
     std::string db_path_;
     std::unique_ptr<SQLite::Database> database_;
-    std::mutex db_mutex_;
+    std::recursive_mutex db_mutex_;   // recursive: the public writes also run inside a WriteTransaction
+    std::unique_ptr<WriteTransaction> open_txn_;   // beginTransaction(); guarded by db_mutex_
+    // prepared once, reused by every insert / update path (declared after database_: finalized first)
+    std::unordered_map<std::string, std::unique_ptr<SQLite::Statement>> statements_;
+
+    // read-only connections for the get* queries: in WAL mode they read the last committed snapshot
+    // concurrently with the writer connection; without WAL (":memory:") a lease is the writer under db_mutex_
+    class ReaderLease {
+    public:
+        explicit ReaderLease(SeatDatabase& db);
+        ~ReaderLease();
+        SQLite::Database& db() { return *conn_; }
+    private:
+        SeatDatabase& owner_;
+        SQLite::Database* conn_ = nullptr;
+        std::unique_ptr<SQLite::Database> pooled_;
+        std::unique_lock<std::recursive_mutex> writer_lock_;
+    };
+    static constexpr size_t kMaxReaders = 4;
+    std::mutex pool_mutex_;
+    std::condition_variable pool_cv_;
+    std::vector<std::unique_ptr<SQLite::Database>> idle_readers_;
+    size_t open_readers_ = 0;
+    bool readers_enabled_ = false;
+
+    // seat events -> per-seat, per-hour occupied time in seat_agg_hourly (see HourlyRollup)
+    HourlyRollup rollup_;
+    bool rollup_loaded_ = false;
+    std::vector<HourBucketDelta> rollup_buckets_;
+    std::vector<std::pair<std::string, int64_t>> rollup_cursors_;
+    bool loadHourlyRollup();   // initialize(): rebuild from seat_events or seed from seat_current
+    void flushRollup();        // caller holds db_mutex_; own savepoint, errors logged
+    // occupied ms per seat from the seat_intervals running sums; one seat if seat_id is non-empty
+    std::map<std::string, int64_t> occupiedMs(SQLite::Database& conn, const std::string& seat_id,
+                                              int64_t start_ms, int64_t end_ms);
+    int64_t dataClockMs(SQLite::Database& conn);   // newest committed event / snapshot ts
+    void hourlyOccupancy(SQLite::Database& conn, int64_t from_hour_ms, int hours, std::vector<double>& rates);
+
+    // seat_intervals + committed seat_events in memory (see OccupancyCache); the queries catch it up
+    // from seat_events first, so rows the judger writes from another process are included too
+    OccupancyCache occupancy_;
+    std::mutex occupancy_mutex_;
+    int64_t occupancy_event_id_ = 0;   // newest seat_events row folded in
+    bool occupancy_loaded_ = false;
+    std::atomic<bool> occupancy_enabled_{true};
+    void loadOccupancyCache();                       // initialize(), caller holds db_mutex_; errors logged
+    bool catchUpOccupancy(SQLite::Database& conn);   // caller holds occupancy_mutex_; false = use SQLite
+
+    // zone counters: every seat in `seats` plus the seats seen in events (zone -1 until inserted)
+    struct ZoneSeat {
+        int zone = -1;            // index into zones_, -1 = no zone
+        bool occupied = false;    // Seated / Anomaly
+        int64_t ts_ms = 0;        // newest event; older ones are ignored, as by seat_current
+        int roi_x = 0, roi_y = 0, roi_width = 0, roi_height = 0;
+    };
+    std::mutex zone_mutex_;       // zones_ / zone_seats_; taken after db_mutex_
+    std::vector<ZoneStatus> zones_;
+    std::unordered_map<std::string, ZoneSeat> zone_seats_;
+    std::function<void(const ZoneStatus&)> zone_listener_;   // guarded by db_mutex_
+    bool loadZones();   // caller holds db_mutex_
+    // caller holds db_mutex_; the zones whose counters changed go to zone_listener_
+    void observeZone(const std::string& seat_id, const std::string& state, int64_t ts_ms);
+    void assignZone(const std::string& seat_id, int zone_id, const std::string& zone,
+                    int roi_x, int roi_y, int roi_width, int roi_height);
+    void notifyZones(const std::vector<ZoneStatus>& changed);
+    void updateZoneBox(int zone);   // caller holds zone_mutex_
+
+    friend class SeatDbWriter;   // group commit: runs the row writers below in its own transactions
+    friend class SeatDbRetention;   // batched deletes in its own short transactions
+    friend class SeatDbBackup;      // backup steps on the writer connection
+
+    // caller holds db_mutex_; statement is reset and its bindings cleared
+    SQLite::Statement& cachedStatement(const std::string& sql);
+
+    // row writers shared by the insert* calls and SeatDbWriter; caller holds db_mutex_, errors are thrown
+    bool writeSeatEvent(const std::string& seat_id, const std::string& state, int64_t ts_ms, int duration_sec);
+    bool writeSnapshot(int64_t ts_ms, const std::string& seat_id, const std::string& state, int person_count);
+    bool writeHourlyAggregation(int64_t hour_ms, const std::string& seat_id, int occupied_minutes);
+    bool writeAlert(const std::string& alert_id, const std::string& seat_id, const std::string& alert_type,
+                    const std::string& alert_desc, int64_t ts_ms, bool is_processed);
+    bool writeAlertUpsert(const std::string& alert_id, const std::string& seat_id, const std::string& alert_type,
+                          const std::string& alert_desc, int64_t opened_ts_ms, int64_t last_ts_ms,
+                          int duration_sec, int64_t resolved_ts_ms);
     
     bool createTables();
-    bool createIndexes();
+    bool createIndexes();                // DatabaseSchemas::SCHEMA_VERSIONS newer than PRAGMA user_version
+    bool migrateTimestampsToEpochMs();   // pre-epoch databases: TEXT timestamps -> INTEGER ms
+    bool addMissingColumns();            // DatabaseSchemas::ADDED_COLUMNS on older databases
+    bool hasColumn(const std::string& table, const std::string& column);
 };
 
 #endif // SEAT_DATABASE_H
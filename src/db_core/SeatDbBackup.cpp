@@ -0,0 +1,133 @@
+#include "SeatDbBackup.h"
+#include "SeatDatabase.h"
+#include "TimeUtils.h"
+#include <SQLiteCpp/Backup.h>
+#include <sqlite3.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+SeatDbBackup::SeatDbBackup(SeatDatabase& db, const SeatDbBackupConfig& cfg)
+    : db_(db), cfg_(cfg) {
+    if (cfg_.pages_per_step <= 0) cfg_.pages_per_step = 1;
+    if (cfg_.keep < 1) cfg_.keep = 1;
+}
+
+std::string SeatDbBackup::backupDir() const {
+    if (!cfg_.dir.empty()) return cfg_.dir;
+    return (fs::path(db_.db_path_).parent_path() / "backups").string();
+}
+
+SeatDbBackupResult SeatDbBackup::run() {
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    SeatDbBackupResult result;
+    if (db_.db_path_ == ":memory:") {
+        result.error = "in-memory database";
+        return result;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto t0 = Clock::now();
+    const std::string dir = backupDir();
+    const std::string prefix = fs::path(db_.db_path_).stem().string() + "-";
+
+    // "YYYY-MM-DD HH:MM:SS" -> "YYYYMMDD-HHMMSS"
+    std::string stamp;
+    for (char ch : TimeUtils::fromEpochMs(TimeUtils::nowMs())) {
+        if (ch == ' ') stamp += '-';
+        else if (ch != '-' && ch != ':') stamp += ch;
+    }
+    const std::string final_path = (fs::path(dir) / (prefix + stamp + ".db")).string();
+    const std::string partial_path = final_path + ".partial";
+
+    try {
+        fs::create_directories(dir);
+        fs::remove(partial_path);
+        {
+            SQLite::Database dest(partial_path, SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+            // no fsync inside the steps (the last one would hold the writer for it); synced once below
+            dest.exec("PRAGMA synchronous = OFF");
+            std::unique_ptr<SQLite::Backup> backup;
+            {
+                std::lock_guard<std::recursive_mutex> lock(db_.db_mutex_);
+                backup = std::make_unique<SQLite::Backup>(dest, *db_.database_);
+            }
+
+            for (;;) {
+                int rc = SQLITE_OK;
+                {
+                    std::lock_guard<std::recursive_mutex> lock(db_.db_mutex_);
+                    const auto s0 = Clock::now();
+                    rc = backup->executeStep(cfg_.pages_per_step);
+                    result.max_step_ms = std::max(result.max_step_ms,
+                                                  std::chrono::duration<double, std::milli>(Clock::now() - s0).count());
+                    result.pages = backup->getTotalPageCount();
+                }
+                ++result.steps;
+                if (rc == SQLITE_DONE) break;
+                if (rc == SQLITE_BUSY || rc == SQLITE_LOCKED) ++result.retries;
+                if (cfg_.step_sleep_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(cfg_.step_sleep_ms));
+            }
+            backup.reset();   // sqlite3_backup_finish
+
+            // the copy is a standalone file: no -wal next to it; rewriting user_version commits with a full fsync
+            dest.exec("PRAGMA journal_mode = DELETE");
+            dest.exec("PRAGMA synchronous = FULL");
+            const int user_version = dest.execAndGet("PRAGMA user_version").getInt();
+            dest.exec("PRAGMA user_version = " + std::to_string(user_version));
+            if (cfg_.verify) {
+                SQLite::Statement check(dest, "PRAGMA integrity_check");
+                result.integrity = check.executeStep() ? check.getColumn(0).getString() : "no result";
+            } else {
+                result.integrity = "skipped";
+            }
+        }
+
+        if (cfg_.verify && result.integrity != "ok") {
+            fs::remove(partial_path);
+            result.error = "integrity_check: " + result.integrity;
+        } else {
+            fs::rename(partial_path, final_path);
+            result.ok = true;
+            result.path = final_path;
+            result.bytes = static_cast<int64_t>(fs::file_size(final_path));
+            rotate(dir, prefix);
+        }
+    } catch (const std::exception& e) {
+        std::error_code ignored;
+        fs::remove(partial_path, ignored);
+        result.error = e.what();
+    }
+
+    result.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    if (result.seconds > 0) result.bytes_per_sec = result.bytes / result.seconds;
+    if (result.ok) {
+        std::cout << "Backup written: " << result.path << " (" << result.bytes << " bytes, " << result.seconds
+                  << " s, " << static_cast<int64_t>(result.bytes_per_sec) << " bytes/s)" << std::endl;
+    } else {
+        std::cerr << "Backup failed: " << result.error << std::endl;
+    }
+    return result;
+}
+
+// newest first by name (the timestamp sorts), keep cfg_.keep
+void SeatDbBackup::rotate(const std::string& dir, const std::string& prefix) {
+    std::vector<fs::path> backups;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        const std::string name = entry.path().filename().string();
+        if (entry.is_regular_file() && name.rfind(prefix, 0) == 0 && entry.path().extension() == ".db") {
+            backups.push_back(entry.path());
+        }
+    }
+    std::sort(backups.begin(), backups.end(), [](const fs::path& a, const fs::path& b) { return a > b; });
+    for (size_t i = static_cast<size_t>(cfg_.keep); i < backups.size(); ++i) {
+        std::error_code ec;
+        fs::remove(backups[i], ec);
+        if (ec) std::cerr << "Remove old backup " << backups[i].string() << " failed: " << ec.message() << std::endl;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef SEAT_DB_BACKUP_H
+#define SEAT_DB_BACKUP_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+class SeatDatabase;
+
+struct SeatDbBackupConfig {
+    std::string dir;               // "" = "backups" next to the database file
+    int keep = 7;                  // newest backups kept, older ones are deleted after a verified copy
+    int pages_per_step = 256;      // pages copied while the writer connection is held ...
+    int step_sleep_ms = 10;        // ... then released for this long
+    bool verify = true;            // PRAGMA integrity_check on the copy before it replaces anything
+};
+
+struct SeatDbBackupResult {
+    bool ok = false;
+    std::string path;              // final backup file
+    int64_t bytes = 0;
+    int pages = 0;
+    int steps = 0;
+    int retries = 0;               // steps that found the database busy / locked
+    double seconds = 0.0;
+    double bytes_per_sec = 0.0;
+    double max_step_ms = 0.0;      // longest time the writer connection was held by one step
+    std::string integrity;         // "ok", the first integrity_check message, or "skipped"
+    std::string error;
+};
+
+// Online backup of the live database with the SQLite backup API
+//   - the copy is made from the writer connection, so rows the app writes during the backup are carried
+//     into the copy instead of restarting it; each step holds the connection for pages_per_step pages only
+//   - written to "<name>-YYYYMMDD-HHMMSS.db.partial", checked, then renamed; the oldest backups beyond
+//     keep are deleted afterwards
+// run() blocks for the whole copy (call it off the UI thread); one backup at a time.
+class SeatDbBackup {
+public:
+    explicit SeatDbBackup(SeatDatabase& db, const SeatDbBackupConfig& cfg = SeatDbBackupConfig());
+
+    SeatDbBackup(const SeatDbBackup&) = delete;
+    SeatDbBackup& operator=(const SeatDbBackup&) = delete;
+
+    SeatDbBackupResult run();
+
+private:
+    std::string backupDir() const;
+    void rotate(const std::string& dir, const std::string& prefix);
+
+    SeatDatabase& db_;
+    SeatDbBackupConfig cfg_;
+    std::mutex run_mutex_;
+};
+
+#endif // SEAT_DB_BACKUP_H
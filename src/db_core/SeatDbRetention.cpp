@@ -0,0 +1,293 @@
+#include "SeatDbRetention.h"
+#include "SeatDatabase.h"
+#include <algorithm>
+#include <chrono>
+#include <initializer_list>
+#include <iostream>
+
+namespace {
+const int64_t kDayMs = 24 * 3600 * 1000LL;
+const char* kDownsampleWatermark = "snapshot_downsampled_ms";
+
+// table + index bytes of a table (dbstat virtual table); -1 when SQLite was built without it
+int64_t tableBytes(SQLite::Database& conn, const std::string& table) {
+    try {
+        SQLite::Statement query(conn, R"(
+            SELECT SUM(pgsize) FROM dbstat
+            WHERE name IN (SELECT name FROM sqlite_master WHERE tbl_name = ?)
+        )");
+        query.bind(1, table);
+        return query.executeStep() ? query.getColumn(0).getInt64() : 0;
+    } catch (const std::exception&) {
+        return -1;
+    }
+}
+
+int64_t countRows(SQLite::Database& conn, const std::string& sql, std::initializer_list<int64_t> binds) {
+    SQLite::Statement query(conn, sql);
+    int index = 1;
+    for (int64_t value : binds) query.bind(index++, value);
+    return query.executeStep() ? query.getColumn(0).getInt64() : 0;
+}
+} // namespace
+
+SeatDbRetention::SeatDbRetention(SeatDatabase& db, const RetentionPolicy& policy)
+    : db_(db), policy_(policy) {
+    if (policy_.batch_rows == 0) policy_.batch_rows = 1;
+}
+
+SeatDbRetention::~SeatDbRetention() {
+    stop();
+}
+
+void SeatDbRetention::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (thread_.joinable()) return;
+    stopping_ = false;
+    thread_ = std::thread(&SeatDbRetention::loop, this);
+}
+
+void SeatDbRetention::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+RetentionReport SeatDbRetention::lastReport() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_;
+}
+
+void SeatDbRetention::loop() {
+    for (;;) {
+        RetentionReport report = runOnce();
+        std::cout << "Retention pass: " << report.snapshots_compacted << " snapshots compacted, "
+                  << report.snapshots_deleted << " snapshots and " << report.events_deleted
+                  << " events deleted, " << report.freelist_bytes << " bytes vacuumed ("
+                  << report.seconds << " s)" << std::endl;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, std::chrono::seconds(std::max(1, policy_.run_interval_sec)), [&] { return stopping_.load(); });
+        if (stopping_) break;
+    }
+}
+
+bool SeatDbRetention::pause() {
+    if (stopping_) return false;
+    if (policy_.batch_pause_ms > 0) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, std::chrono::milliseconds(policy_.batch_pause_ms), [&] { return stopping_.load(); });
+    }
+    return !stopping_;
+}
+
+SeatDbRetention::Cutoffs SeatDbRetention::cutoffs() {
+    Cutoffs c;
+    std::lock_guard<std::recursive_mutex> lock(db_.db_mutex_);
+    SQLite::Database& conn = *db_.database_;
+    c.clock_ms = db_.dataClockMs(conn);
+    if (c.clock_ms == 0) return c;   // empty database
+
+    if (policy_.snapshot_keep_days > 0) c.snapshot_delete_ms = c.clock_ms - policy_.snapshot_keep_days * kDayMs;
+    if (policy_.event_keep_days > 0) c.event_delete_ms = c.clock_ms - policy_.event_keep_days * kDayMs;
+
+    if (policy_.snapshot_raw_days > 0 && policy_.snapshot_downsample_sec > 0) {
+        const int64_t bucket_ms = policy_.snapshot_downsample_sec * 1000LL;
+        SQLite::Statement mark(conn, "SELECT value FROM retention_state WHERE name = ?");
+        mark.bind(1, kDownsampleWatermark);
+        const int64_t watermark = mark.executeStep() ? mark.getColumn(0).getInt64() : 0;
+        const int64_t from = std::max(watermark, c.snapshot_delete_ms);
+        c.downsample_from_ms = (from + bucket_ms - 1) / bucket_ms * bucket_ms;
+        c.downsample_to_ms = (c.clock_ms - policy_.snapshot_raw_days * kDayMs) / bucket_ms * bucket_ms;
+        if (c.downsample_to_ms < c.downsample_from_ms) c.downsample_to_ms = c.downsample_from_ms;
+    }
+    return c;
+}
+
+RetentionReport SeatDbRetention::preview() {
+    const auto t0 = std::chrono::steady_clock::now();
+    RetentionReport report;
+    report.dry_run = true;
+    try {
+        const Cutoffs c = cutoffs();   // before the lease: without WAL the lease holds the writer's mutex
+        report.clock_ms = c.clock_ms;
+        SeatDatabase::ReaderLease reader(db_);
+        SQLite::Database& conn = reader.db();
+
+        if (c.snapshot_delete_ms > 0) {
+            report.snapshots_deleted = countRows(conn, "SELECT COUNT(*) FROM seat_snapshots WHERE ts_ms < ?",
+                                                 {c.snapshot_delete_ms});
+        }
+        if (c.downsample_to_ms > c.downsample_from_ms) {
+            const int64_t rows = countRows(conn, "SELECT COUNT(*) FROM seat_snapshots WHERE ts_ms >= ? AND ts_ms < ?",
+                                           {c.downsample_from_ms, c.downsample_to_ms});
+            const int64_t kept = countRows(conn, R"(
+                SELECT COUNT(*) FROM (SELECT 1 FROM seat_snapshots WHERE ts_ms >= ? AND ts_ms < ?
+                                      GROUP BY seat_id, ts_ms / ?))",
+                {c.downsample_from_ms, c.downsample_to_ms, policy_.snapshot_downsample_sec * 1000LL});
+            report.snapshots_compacted = rows - kept;
+        }
+        if (c.event_delete_ms > 0) {
+            report.events_deleted = countRows(conn, "SELECT COUNT(*) FROM seat_events WHERE ts_ms < ?",
+                                              {c.event_delete_ms});
+        }
+
+        // bytes: each table's share of its pages, by row count
+        const int64_t snapshot_rows = report.snapshots_compacted + report.snapshots_deleted;
+        const int64_t snapshot_bytes = snapshot_rows > 0 ? tableBytes(conn, "seat_snapshots") : 0;
+        const int64_t event_bytes = report.events_deleted > 0 ? tableBytes(conn, "seat_events") : 0;
+        if (snapshot_bytes >= 0 && event_bytes >= 0) {
+            double bytes = 0.0;
+            if (snapshot_rows > 0) {
+                bytes += static_cast<double>(snapshot_bytes) * snapshot_rows /
+                         std::max<int64_t>(1, countRows(conn, "SELECT COUNT(*) FROM seat_snapshots", {}));
+            }
+            if (report.events_deleted > 0) {
+                bytes += static_cast<double>(event_bytes) * report.events_deleted /
+                         std::max<int64_t>(1, countRows(conn, "SELECT COUNT(*) FROM seat_events", {}));
+            }
+            report.bytes_estimate = static_cast<int64_t>(bytes);
+        }
+
+        const int64_t page_size = conn.execAndGet("PRAGMA page_size").getInt64();
+        report.freelist_bytes = conn.execAndGet("PRAGMA freelist_count").getInt64() * page_size;
+        const int mode = conn.execAndGet("PRAGMA auto_vacuum").getInt();
+        report.auto_vacuum = mode == 2 ? "incremental" : (mode == 1 ? "full" : "none");
+    } catch (const std::exception& e) {
+        std::cerr << "Retention preview failed: " << e.what() << std::endl;
+    }
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return report;
+}
+
+RetentionReport SeatDbRetention::runOnce() {
+    const auto t0 = std::chrono::steady_clock::now();
+    RetentionReport report;
+    report.dry_run = false;
+    try {
+        const Cutoffs c = cutoffs();
+        report.clock_ms = c.clock_ms;
+        // delete first, so downsampling does not thin rows that are about to go anyway
+        if (c.snapshot_delete_ms > 0) {
+            report.snapshots_deleted = deleteOlderThan("seat_snapshots", "snapshot_id", c.snapshot_delete_ms);
+        }
+        if (!stopping_ && c.downsample_to_ms > c.downsample_from_ms) {
+            report.snapshots_compacted = downsampleSnapshots(c);
+        }
+        if (!stopping_ && c.event_delete_ms > 0) {
+            report.events_deleted = deleteOlderThan("seat_events", "event_id", c.event_delete_ms);
+        }
+        if (!stopping_) report.freelist_bytes = incrementalVacuum();
+
+        std::lock_guard<std::recursive_mutex> db_lock(db_.db_mutex_);
+        const int mode = db_.database_->execAndGet("PRAGMA auto_vacuum").getInt();
+        report.auto_vacuum = mode == 2 ? "incremental" : (mode == 1 ? "full" : "none");
+    } catch (const std::exception& e) {
+        std::cerr << "Retention pass failed: " << e.what() << std::endl;
+    }
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_ = report;
+    return report;
+}
+
+// oldest rows first, batch_rows per transaction (ts_ms index), until nothing older than the cut-off is left
+int64_t SeatDbRetention::deleteOlderThan(const char* table, const char* id_column, int64_t cutoff_ms) {
+    const std::string sql = std::string("DELETE FROM ") + table + " WHERE " + id_column + " IN (SELECT " + id_column +
+                            " FROM " + table + " WHERE ts_ms < ? ORDER BY ts_ms LIMIT ?)";
+    int64_t deleted = 0;
+    for (;;) {
+        int changed = 0;
+        {
+            std::lock_guard<std::recursive_mutex> lock(db_.db_mutex_);
+            SQLite::Transaction txn(*db_.database_);
+            SQLite::Statement& del = db_.cachedStatement(sql);
+            del.bind(1, cutoff_ms);
+            del.bind(2, static_cast<int64_t>(policy_.batch_rows));
+            changed = del.exec();
+            txn.commit();
+        }
+        deleted += changed;
+        if (changed < static_cast<int>(policy_.batch_rows) || !pause()) break;
+    }
+    return deleted;
+}
+
+// keep the first snapshot per seat per bucket; slices of about batch_rows rows, whole buckets only,
+// each slice and the watermark move in one transaction
+int64_t SeatDbRetention::downsampleSnapshots(const Cutoffs& c) {
+    const int64_t bucket_ms = policy_.snapshot_downsample_sec * 1000LL;
+    int64_t from = c.downsample_from_ms;
+    int64_t compacted = 0;
+    while (from < c.downsample_to_ms) {
+        {
+            std::lock_guard<std::recursive_mutex> lock(db_.db_mutex_);
+            SQLite::Database& conn = *db_.database_;
+
+            int64_t to = c.downsample_to_ms;
+            SQLite::Statement& next = db_.cachedStatement(
+                "SELECT ts_ms FROM seat_snapshots WHERE ts_ms >= ? AND ts_ms < ? ORDER BY ts_ms LIMIT 1 OFFSET ?");
+            next.bind(1, from);
+            next.bind(2, c.downsample_to_ms);
+            next.bind(3, static_cast<int64_t>(policy_.batch_rows));
+            if (next.executeStep()) to = std::max(from + bucket_ms, next.getColumn(0).getInt64() / bucket_ms * bucket_ms);
+            next.reset();
+
+            SQLite::Transaction txn(conn);
+            SQLite::Statement& thin = db_.cachedStatement(R"(
+                DELETE FROM seat_snapshots
+                WHERE ts_ms >= ?1 AND ts_ms < ?2
+                  AND snapshot_id NOT IN (SELECT MIN(snapshot_id) FROM seat_snapshots
+                                          WHERE ts_ms >= ?1 AND ts_ms < ?2
+                                          GROUP BY seat_id, ts_ms / ?3)
+            )");
+            thin.bind(1, from);
+            thin.bind(2, to);
+            thin.bind(3, bucket_ms);
+            compacted += thin.exec();
+
+            SQLite::Statement& mark = db_.cachedStatement(
+                "INSERT INTO retention_state (name, value) VALUES (?, ?) "
+                "ON CONFLICT(name) DO UPDATE SET value = excluded.value");
+            mark.bind(1, kDownsampleWatermark);
+            mark.bind(2, to);
+            mark.exec();
+            txn.commit();
+            from = to;
+        }
+        if (from < c.downsample_to_ms && !pause()) break;
+    }
+    return compacted;
+}
+
+// returns the bytes given back to the file system
+int64_t SeatDbRetention::incrementalVacuum() {
+    if (policy_.vacuum_pages <= 0) return 0;
+    std::lock_guard<std::recursive_mutex> lock(db_.db_mutex_);
+    SQLite::Database& conn = *db_.database_;
+    if (conn.execAndGet("PRAGMA auto_vacuum").getInt() != 2) return 0;
+    const int64_t before = conn.execAndGet("PRAGMA freelist_count").getInt64();
+    conn.exec("PRAGMA incremental_vacuum(" + std::to_string(policy_.vacuum_pages) + ")");
+    const int64_t after = conn.execAndGet("PRAGMA freelist_count").getInt64();
+    return (before - after) * conn.execAndGet("PRAGMA page_size").getInt64();
+}
+
+bool SeatDbRetention::enableIncrementalVacuum() {
+    std::lock_guard<std::recursive_mutex> lock(db_.db_mutex_);
+    try {
+        SQLite::Database& conn = *db_.database_;
+        if (conn.execAndGet("PRAGMA auto_vacuum").getInt() == 2) return true;
+        conn.exec("PRAGMA auto_vacuum = INCREMENTAL");
+        conn.exec("VACUUM");
+        std::cout << "auto_vacuum set to INCREMENTAL (database rebuilt)" << std::endl;
+        return conn.execAndGet("PRAGMA auto_vacuum").getInt() == 2;
+    } catch (const std::exception& e) {
+        std::cerr << "Enable incremental vacuum failed: " << e.what() << std::endl;
+        return false;
+    }
+}
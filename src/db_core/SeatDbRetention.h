@@ -0,0 +1,89 @@
+#ifndef SEAT_DB_RETENTION_H
+#define SEAT_DB_RETENTION_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class SeatDatabase;
+
+// Age limits are relative to the newest event / snapshot ts (the data clock), not the wall clock,
+// so a database that was offline for a while is not emptied on the next start; 0 disables a step
+struct RetentionPolicy {
+    int snapshot_raw_days = 7;          // seat_snapshots newer than this are kept as written ...
+    int snapshot_downsample_sec = 60;   // ... older ones are thinned to the first one per seat per bucket
+    int snapshot_keep_days = 90;        // seat_snapshots older than this are deleted
+    int event_keep_days = 365;          // seat_events older than this are deleted (seat_intervals /
+                                        // seat_agg_hourly keep the history they were folded into)
+    size_t batch_rows = 2000;           // rows per delete transaction
+    int batch_pause_ms = 20;            // between batches, so the writer is never held up for long
+    int run_interval_sec = 3600;        // background pass (start())
+    int vacuum_pages = 2000;            // PRAGMA incremental_vacuum(N) per pass (auto_vacuum = INCREMENTAL)
+};
+
+struct RetentionReport {
+    bool dry_run = true;
+    int64_t clock_ms = 0;               // data clock the cut-offs were taken from
+    int64_t snapshots_compacted = 0;    // thinned by downsampling
+    int64_t snapshots_deleted = 0;      // past snapshot_keep_days
+    int64_t events_deleted = 0;         // past event_keep_days
+    int64_t bytes_estimate = -1;        // table + index bytes of those rows (dbstat); -1 if unavailable
+    int64_t freelist_bytes = 0;         // dry run: free pages in the file; run: bytes returned by incremental_vacuum
+    std::string auto_vacuum;            // "none" / "full" / "incremental"
+    double seconds = 0.0;
+};
+
+// Retention, downsampling and compaction for seat_snapshots / seat_events
+//   - every step deletes in transactions of batch_rows and releases the database between them
+//   - downsampling walks forward from a watermark kept in retention_state, so a pass only touches
+//     snapshots that aged past snapshot_raw_days since the previous one
+//   - incremental_vacuum needs auto_vacuum = INCREMENTAL: new databases get it when they are created,
+//     older ones once through enableIncrementalVacuum() (a full VACUUM, blocks the writer)
+// runOnce() / preview() may be called from any thread; start() runs passes on a background thread.
+class SeatDbRetention {
+public:
+    explicit SeatDbRetention(SeatDatabase& db, const RetentionPolicy& policy = RetentionPolicy());
+    ~SeatDbRetention();
+
+    SeatDbRetention(const SeatDbRetention&) = delete;
+    SeatDbRetention& operator=(const SeatDbRetention&) = delete;
+
+    RetentionReport preview();   // dry run: what runOnce() would remove now, nothing is changed
+    RetentionReport runOnce();
+
+    void start();   // a pass now, then every run_interval_sec
+    void stop();    // the current batch finishes, the rest of the pass is skipped
+
+    bool enableIncrementalVacuum();
+    RetentionReport lastReport() const;
+
+private:
+    struct Cutoffs {
+        int64_t clock_ms = 0;
+        int64_t snapshot_delete_ms = 0;     // delete ts_ms < this (0 = keep)
+        int64_t downsample_from_ms = 0;     // thin [from, to), bucket aligned
+        int64_t downsample_to_ms = 0;
+        int64_t event_delete_ms = 0;
+    };
+    Cutoffs cutoffs();
+    int64_t deleteOlderThan(const char* table, const char* id_column, int64_t cutoff_ms);
+    int64_t downsampleSnapshots(const Cutoffs& c);
+    int64_t incrementalVacuum();
+    bool pause();   // false once stopping
+
+    void loop();
+
+    SeatDatabase& db_;
+    RetentionPolicy policy_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<bool> stopping_{false};
+    RetentionReport last_;
+    std::thread thread_;
+};
+
+#endif // SEAT_DB_RETENTION_H
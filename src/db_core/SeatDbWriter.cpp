@@ -0,0 +1,203 @@
+#include "SeatDbWriter.h"
+#include "SeatDatabase.h"
+#include <algorithm>
+#include <iostream>
+
+SeatDbWriter::SeatDbWriter(SeatDatabase& db, const SeatDbWriterConfig& cfg)
+    : db_(db), cfg_(cfg) {
+    if (cfg_.max_batch_rows == 0) cfg_.max_batch_rows = 1;
+    if (cfg_.max_queued_rows < cfg_.max_batch_rows) cfg_.max_queued_rows = cfg_.max_batch_rows;
+    thread_ = std::thread(&SeatDbWriter::loop, this);
+}
+
+SeatDbWriter::~SeatDbWriter() {
+    stop();
+}
+
+void SeatDbWriter::insertSeatEvent(const std::string& seat_id, const std::string& state,
+                                   int64_t ts_ms, int duration_sec) {
+    WriteOp op;
+    op.kind = WriteOp::Kind::SeatEvent;
+    op.seat_id = seat_id;
+    op.state = state;
+    op.ts_ms = ts_ms;
+    op.value = duration_sec;
+    enqueue(std::move(op));
+}
+
+void SeatDbWriter::insertSnapshot(int64_t ts_ms, const std::string& seat_id,
+                                  const std::string& state, int person_count) {
+    WriteOp op;
+    op.kind = WriteOp::Kind::Snapshot;
+    op.seat_id = seat_id;
+    op.state = state;
+    op.ts_ms = ts_ms;
+    op.value = person_count;
+    enqueue(std::move(op));
+}
+
+void SeatDbWriter::insertHourlyAggregation(int64_t hour_ms, const std::string& seat_id, int occupied_minutes) {
+    WriteOp op;
+    op.kind = WriteOp::Kind::HourlyAggregation;
+    op.seat_id = seat_id;
+    op.ts_ms = hour_ms;
+    op.value = occupied_minutes;
+    enqueue(std::move(op));
+}
+
+void SeatDbWriter::insertAlert(const std::string& alert_id, const std::string& seat_id,
+                               const std::string& alert_type, const std::string& alert_desc,
+                               int64_t ts_ms, bool is_processed) {
+    WriteOp op;
+    op.kind = WriteOp::Kind::Alert;
+    op.alert_id = alert_id;
+    op.seat_id = seat_id;
+    op.state = alert_type;
+    op.alert_desc = alert_desc;
+    op.ts_ms = ts_ms;
+    op.value = is_processed ? 1 : 0;
+    enqueue(std::move(op));
+}
+
+void SeatDbWriter::upsertAlert(const std::string& alert_id, const std::string& seat_id,
+                               const std::string& alert_type, const std::string& alert_desc,
+                               int64_t opened_ts_ms, int64_t last_ts_ms,
+                               int duration_sec, int64_t resolved_ts_ms) {
+    WriteOp op;
+    op.kind = WriteOp::Kind::AlertUpsert;
+    op.alert_id = alert_id;
+    op.seat_id = seat_id;
+    op.state = alert_type;
+    op.alert_desc = alert_desc;
+    op.ts_ms = opened_ts_ms;
+    op.last_ts_ms = last_ts_ms;
+    op.resolved_ts_ms = resolved_ts_ms;
+    op.value = duration_sec;
+    enqueue(std::move(op));
+}
+
+void SeatDbWriter::enqueue(WriteOp&& op) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [&] { return stopping_ || queue_.size() < cfg_.max_queued_rows; });
+    if (stopping_) return;
+    if (queue_.empty()) group_start_ = std::chrono::steady_clock::now();
+    queue_.push_back(std::move(op));
+    ++queued_seq_;
+    if (queue_.size() == 1 || queue_.size() >= cfg_.max_batch_rows) work_cv_.notify_one();
+}
+
+void SeatDbWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t target = queued_seq_;
+    if (written_seq_ >= target) return;
+    ++flush_waiters_;
+    work_cv_.notify_one();
+    done_cv_.wait(lock, [&] { return written_seq_ >= target || finished_; });
+    --flush_waiters_;
+}
+
+void SeatDbWriter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return;
+        stopping_ = true;
+    }
+    work_cv_.notify_one();
+    done_cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+size_t SeatDbWriter::queuedRows() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+SeatDbWriterStats SeatDbWriter::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void SeatDbWriter::loop() {
+    std::vector<WriteOp> batch;
+    batch.reserve(cfg_.max_batch_rows);
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        work_cv_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) break;   // stopping, nothing left
+
+        // group commit: wait for a full group, the group's deadline, a flush() or stop()
+        const auto deadline = group_start_ + std::chrono::milliseconds(cfg_.max_batch_delay_ms);
+        work_cv_.wait_until(lock, deadline, [&] {
+            return stopping_ || flush_waiters_ > 0 || queue_.size() >= cfg_.max_batch_rows;
+        });
+
+        const size_t n = std::min(queue_.size(), cfg_.max_batch_rows);
+        batch.clear();
+        for (size_t i = 0; i < n; ++i) {
+            batch.push_back(std::move(queue_.front()));
+            queue_.pop_front();
+        }
+        if (!queue_.empty()) group_start_ = std::chrono::steady_clock::now();
+        done_cv_.notify_all();   // room for blocked producers
+
+        const bool idle = queue_.empty();
+        lock.unlock();
+        writeBatch(batch, idle);
+        lock.lock();
+
+        written_seq_ += n;
+        done_cv_.notify_all();
+    }
+    finished_ = true;
+    done_cv_.notify_all();
+}
+
+void SeatDbWriter::writeBatch(std::vector<WriteOp>& batch, bool idle) {
+    uint64_t failed = 0;
+    SeatDatabase::WriteTransaction txn(db_);   // writer lock until the end of the batch
+    bool committed = false;
+    try {
+        if (txn.active()) {
+            for (const auto& op : batch) writeOne(op);
+            // queue drained: the hour in progress reaches seat_agg_hourly with the rows it was folded from
+            if (idle && db_.rollup_loaded_) db_.flushRollup();
+            committed = txn.commit();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Group commit of " << batch.size() << " rows failed, retrying row by row: " << e.what() << std::endl;
+    }
+    if (!committed) {
+        txn.rollback();   // also puts the rollup back, so the replayed events are counted again
+        for (const auto& op : batch) {
+            try {
+                writeOne(op);
+            } catch (const std::exception& row_error) {
+                std::cerr << "Write of " << op.seat_id << " row failed: " << row_error.what() << std::endl;
+                ++failed;
+            }
+        }
+        if (idle && db_.rollup_loaded_) db_.flushRollup();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.rows += batch.size() - failed;
+    stats_.failed_rows += failed;
+    stats_.batches += 1;
+}
+
+bool SeatDbWriter::writeOne(const WriteOp& op) {
+    switch (op.kind) {
+    case WriteOp::Kind::SeatEvent:
+        return db_.writeSeatEvent(op.seat_id, op.state, op.ts_ms, op.value);
+    case WriteOp::Kind::Snapshot:
+        return db_.writeSnapshot(op.ts_ms, op.seat_id, op.state, op.value);
+    case WriteOp::Kind::HourlyAggregation:
+        return db_.writeHourlyAggregation(op.ts_ms, op.seat_id, op.value);
+    case WriteOp::Kind::Alert:
+        return db_.writeAlert(op.alert_id, op.seat_id, op.state, op.alert_desc, op.ts_ms, op.value != 0);
+    case WriteOp::Kind::AlertUpsert:
+        return db_.writeAlertUpsert(op.alert_id, op.seat_id, op.state, op.alert_desc,
+                                    op.ts_ms, op.last_ts_ms, op.value, op.resolved_ts_ms);
+    }
+    return false;
+}
@@ -0,0 +1,95 @@
+#ifndef SEAT_DB_WRITER_H
+#define SEAT_DB_WRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class SeatDatabase;
+
+struct SeatDbWriterConfig {
+    size_t max_batch_rows = 500;      // commit once this many rows are queued ...
+    int max_batch_delay_ms = 50;      // ... or this long after the first row of the group, whichever first
+    size_t max_queued_rows = 100000;  // producers block above this (back-pressure instead of unbounded memory)
+};
+
+struct SeatDbWriterStats {
+    uint64_t rows = 0;            // rows written
+    uint64_t batches = 0;         // transactions committed
+    uint64_t failed_rows = 0;     // rows rejected by SQLite (logged, not retried)
+};
+
+// Group-commit writer for SeatDatabase
+//   - insert* / upsertAlert only queue the row and return; one background thread writes the rows
+//     in transactions of up to max_batch_rows, using SeatDatabase's cached prepared statements
+//   - rows are written in queue order; a failing batch is rolled back and replayed row by row,
+//     so one bad row does not drop the rest of its group
+//   - flush() is a barrier: it returns once every row queued before the call is committed
+// Thread-safe; the destructor writes what is still queued before it returns.
+class SeatDbWriter {
+public:
+    explicit SeatDbWriter(SeatDatabase& db, const SeatDbWriterConfig& cfg = SeatDbWriterConfig());
+    ~SeatDbWriter();
+
+    SeatDbWriter(const SeatDbWriter&) = delete;
+    SeatDbWriter& operator=(const SeatDbWriter&) = delete;
+
+    // same arguments as the SeatDatabase calls they replace (all times epoch ms)
+    void insertSeatEvent(const std::string& seat_id, const std::string& state, int64_t ts_ms, int duration_sec = 0);
+    void insertSnapshot(int64_t ts_ms, const std::string& seat_id, const std::string& state, int person_count = 0);
+    void insertHourlyAggregation(int64_t hour_ms, const std::string& seat_id, int occupied_minutes);
+    void insertAlert(const std::string& alert_id, const std::string& seat_id, const std::string& alert_type,
+                     const std::string& alert_desc, int64_t ts_ms, bool is_processed = false);
+    void upsertAlert(const std::string& alert_id, const std::string& seat_id, const std::string& alert_type,
+                     const std::string& alert_desc, int64_t opened_ts_ms, int64_t last_ts_ms,
+                     int duration_sec, int64_t resolved_ts_ms);
+
+    void flush();   // barrier, see above
+    void stop();    // flush, then end the writer thread; further rows are dropped
+
+    size_t queuedRows() const;
+    SeatDbWriterStats stats() const;
+
+private:
+    struct WriteOp {
+        enum class Kind : uint8_t { SeatEvent, Snapshot, HourlyAggregation, Alert, AlertUpsert };
+        Kind kind = Kind::SeatEvent;
+        std::string seat_id;
+        std::string state;          // event / snapshot state, alert type
+        std::string alert_id;
+        std::string alert_desc;
+        int64_t ts_ms = 0;          // event / snapshot ts, hour start, alert opened
+        int64_t last_ts_ms = 0;
+        int64_t resolved_ts_ms = 0;
+        int value = 0;              // duration_sec / person_count / occupied_minutes / is_processed
+    };
+
+    void enqueue(WriteOp&& op);
+    void loop();
+    void writeBatch(std::vector<WriteOp>& batch, bool idle);   // idle = queue empty after this batch
+    bool writeOne(const WriteOp& op);   // caller holds the database mutex
+
+    SeatDatabase& db_;
+    SeatDbWriterConfig cfg_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;    // writer: rows queued / flush requested / stop
+    std::condition_variable done_cv_;    // flush() waiters and blocked producers
+    std::deque<WriteOp> queue_;
+    std::chrono::steady_clock::time_point group_start_;
+    uint64_t queued_seq_ = 0;            // rows ever queued
+    uint64_t written_seq_ = 0;           // rows ever taken and written (committed or failed)
+    int flush_waiters_ = 0;
+    bool stopping_ = false;
+    bool finished_ = false;              // writer thread has exited
+    SeatDbWriterStats stats_;
+
+    std::thread thread_;
+};
+
+#endif // SEAT_DB_WRITER_H
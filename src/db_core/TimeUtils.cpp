@@ -103,6 +103,19 @@ bool TimeUtils::isSameDay(const std::string& timestamp1, const std::string& time
             tm1.tm_mday == tm2.tm_mday);
 }
 
+int64_t TimeUtils::nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+int64_t TimeUtils::toEpochMs(const std::string& timestamp) {
+    return static_cast<int64_t>(stringToTime(timestamp)) * 1000;
+}
+
+std::string TimeUtils::fromEpochMs(int64_t ts_ms) {
+    return timeToString(static_cast<time_t>(ts_ms / 1000));
+}
+
 time_t TimeUtils::stringToTime(const std::string& timestamp) {
     std::tm tm = {};
     std::istringstream ss(timestamp);
@@ -111,6 +124,7 @@ time_t TimeUtils::stringToTime(const std::string& timestamp) {
     if (ss.fail()) {
         throw std::runtime_error("Failed to parse timestamp: " + timestamp);
     }
+    tm.tm_isdst = -1; // let mktime decide DST for the local time
     
     return std::mktime(&tm);
 }
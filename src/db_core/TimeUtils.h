@@ -3,6 +3,7 @@
 
 #include <string>
 #include <chrono>
+#include <cstdint>
 
 class TimeUtils {
 public:
@@ -12,6 +13,11 @@ public:
     static std::string getHourStart(const std::string& timestamp);
     static int getMinutesBetween(const std::string& start, const std::string& end);
     static bool isSameDay(const std::string& timestamp1, const std::string& timestamp2);
+
+    // epoch milliseconds <-> local "YYYY-MM-DD HH:MM:SS" (DB stores ms, strings only at the edges)
+    static int64_t nowMs();
+    static int64_t toEpochMs(const std::string& timestamp);
+    static std::string fromEpochMs(int64_t ts_ms);
     
 private:
     static time_t stringToTime(const std::string& timestamp);
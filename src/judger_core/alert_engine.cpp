@@ -0,0 +1,106 @@
+#include "seatui/judger/alert_engine.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+void AlertEngine::observe(const string& seat_id, const vector<B2CD_Alert>& raised, int64_t ts_ms) {
+    if (raised.empty() && open_count_ == 0) return;   // common case: nothing raised, nothing open
+
+    auto it = open_.find(seat_id);
+    if (raised.empty() && it == open_.end()) return;
+    if (it == open_.end()) it = open_.emplace(seat_id, vector<OpenAlert>()).first;
+    vector<OpenAlert>& open = it->second;
+
+    // signals of this frame: open or extend
+    for (const auto& a : raised) {
+        OpenAlert* cur = nullptr;
+        for (auto& o : open) {
+            if (o.rec.alert_type == a.alert_type) cur = &o;
+        }
+        if (!cur) {
+            OpenAlert o;
+            o.rec.alert_id = seat_id + "_" + a.alert_type + "_" + to_string(ts_ms);
+            o.rec.seat_id = seat_id;
+            o.rec.alert_type = a.alert_type;
+            o.rec.alert_desc = a.alert_desc;
+            o.rec.opened_ms = ts_ms;
+            o.rec.last_ms = ts_ms;
+            o.rec.duration_sec = a.duration_sec;
+            o.written_ms = ts_ms;
+            open.push_back(o);
+            ++open_count_;
+            queue(open.back().rec);
+            continue;
+        }
+        cur->absent_since = 0;
+        cur->rec.alert_desc = a.alert_desc;
+        cur->rec.last_ms = ts_ms;
+        cur->rec.duration_sec = max(cur->rec.duration_sec, a.duration_sec);
+        if (ts_ms - cur->written_ms >= cfg_.update_interval_ms) {
+            cur->written_ms = ts_ms;
+            queue(cur->rec);
+        }
+    }
+
+    // open alerts without a signal: close once absent long enough
+    for (size_t i = 0; i < open.size();) {
+        OpenAlert& o = open[i];
+        bool present = false;
+        for (const auto& a : raised) present = present || a.alert_type == o.rec.alert_type;
+        if (present) {
+            ++i;
+            continue;
+        }
+        if (o.absent_since == 0) o.absent_since = ts_ms;
+        if (ts_ms - o.absent_since < cfg_.resolve_after_ms) {
+            ++i;
+            continue;
+        }
+        o.rec.resolved_ms = o.absent_since;
+        queue(o.rec);
+        open[i] = std::move(open.back());
+        open.pop_back();
+        --open_count_;
+    }
+    if (open.empty()) open_.erase(it);
+}
+
+void AlertEngine::restoreOpen(const AlertRecord& rec) {
+    auto& open = open_[rec.seat_id];
+    for (const auto& o : open) {
+        if (o.rec.alert_type == rec.alert_type) return;
+    }
+    OpenAlert o;
+    o.rec = rec;
+    o.rec.resolved_ms = 0;
+    o.written_ms = rec.last_ms;
+    open.push_back(o);
+    ++open_count_;
+}
+
+void AlertEngine::queueOpen() {
+    for (auto& seat : open_) {
+        for (auto& o : seat.second) {
+            if (o.written_ms == o.rec.last_ms) continue;
+            o.written_ms = o.rec.last_ms;
+            queue(o.rec);
+        }
+    }
+}
+
+void AlertEngine::queue(const AlertRecord& rec) {
+    auto it = pending_index_.find(rec.alert_id);
+    if (it != pending_index_.end()) {
+        pending_order_[it->second] = rec;   // newer state of the same row replaces the queued one
+        return;
+    }
+    pending_index_.emplace(rec.alert_id, pending_order_.size());
+    pending_order_.push_back(rec);
+}
+
+void AlertEngine::takePending(vector<AlertRecord>& out) {
+    out.clear();
+    out.swap(pending_order_);
+    pending_index_.clear();
+}
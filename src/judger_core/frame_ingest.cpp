@@ -0,0 +1,139 @@
+#include "seatui/judger/frame_ingest.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+using namespace std;
+
+// A also writes the rolling "latest frame" file into the same directory; it is not a new frame
+static const char* kLatestFrameFile = "last_frame.jsonl";
+
+JsonlDirWatcher::JsonlDirWatcher(const string& dir, JudgerInputQueue& queue, int poll_ms)
+    : dir_(dir), queue_(queue), poll_ms_(poll_ms > 0 ? poll_ms : 2000) {}
+
+JsonlDirWatcher::~JsonlDirWatcher() {
+    stop();
+}
+
+void JsonlDirWatcher::offer(const string& filename) {
+    if (fs::path(filename).extension() != ".jsonl") return;
+    if (filename == kLatestFrameFile) return;
+
+    fs::path path = fs::path(dir_) / filename;
+    error_code ec;
+    uintmax_t size = fs::file_size(path, ec);
+    if (ec) return;
+    long long mtime = static_cast<long long>(fs::last_write_time(path, ec).time_since_epoch().count());
+    auto sig = make_pair(size, mtime);
+    auto it = offered_.find(filename);
+    if (it != offered_.end() && it->second == sig) return;     // unchanged since last offer
+    offered_[filename] = sig;
+
+    JudgerInput in;
+    in.jsonl_path = path.string();
+    queue_.push(std::move(in));
+}
+
+void JsonlDirWatcher::scanDirectory() {
+    try {
+        // sorted so a backlog of frames is replayed in frame order
+        vector<string> names;
+        for (auto& entry : fs::directory_iterator(dir_)) {
+            if (entry.is_regular_file()) names.push_back(entry.path().filename().string());
+        }
+        sort(names.begin(), names.end());
+        for (auto& n : names) offer(n);
+    } catch (const std::exception& e) {
+        cout << "[B] Error while scanning JSONL directory: " << e.what() << endl;
+    }
+}
+
+bool JsonlDirWatcher::start() {
+    if (!fs::exists(dir_) || !fs::is_directory(dir_)) {
+        cout << "[B] Error: JSONL directory does not exist: " << dir_ << endl;
+        return false;
+    }
+    stop_ = false;
+
+#ifdef __linux__
+    // register the watch before the initial scan so nothing written in between is lost
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ >= 0) {
+        watch_fd_ = inotify_add_watch(inotify_fd_, dir_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MODIFY);
+        if (watch_fd_ < 0) {
+            close(inotify_fd_);
+            inotify_fd_ = -1;
+        }
+    }
+    using_inotify_ = inotify_fd_ >= 0;
+#endif
+
+    scanDirectory();
+
+#ifdef __linux__
+    if (using_inotify_) {
+        cout << "[B] Info: watching " << dir_ << " with inotify" << endl;
+        worker_ = thread(&JsonlDirWatcher::inotifyLoop, this);
+        return true;
+    }
+#endif
+    cout << "[B] Info: watching " << dir_ << " by polling every " << poll_ms_ << " ms" << endl;
+    worker_ = thread(&JsonlDirWatcher::pollLoop, this);
+    return true;
+}
+
+void JsonlDirWatcher::stop() {
+    stop_ = true;
+    if (worker_.joinable()) worker_.join();
+#ifdef __linux__
+    if (inotify_fd_ >= 0) {
+        if (watch_fd_ >= 0) inotify_rm_watch(inotify_fd_, watch_fd_);
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+        watch_fd_ = -1;
+    }
+#endif
+}
+
+void JsonlDirWatcher::pollLoop() {
+    // sleep in short slices so stop() does not wait a full period
+    const auto slice = chrono::milliseconds(min(poll_ms_, 100));
+    while (!stop_) {
+        scanDirectory();
+        auto deadline = chrono::steady_clock::now() + chrono::milliseconds(poll_ms_);
+        while (!stop_ && chrono::steady_clock::now() < deadline) this_thread::sleep_for(slice);
+    }
+}
+
+#ifdef __linux__
+void JsonlDirWatcher::inotifyLoop() {
+    alignas(inotify_event) char buf[4096];
+    pollfd pfd{inotify_fd_, POLLIN, 0};
+    while (!stop_) {
+        // the timeout only bounds how long stop() waits; events wake us immediately
+        int rc = poll(&pfd, 1, 500);
+        if (rc <= 0) continue;
+
+        ssize_t len = read(inotify_fd_, buf, sizeof(buf));
+        if (len <= 0) continue;
+        for (char* p = buf; p < buf + len; ) {
+            auto* ev = reinterpret_cast<inotify_event*>(p);
+            if (ev->mask & IN_Q_OVERFLOW) {
+                scanDirectory();                   // events dropped, fall back to a full scan
+            } else if (ev->len > 0 && !(ev->mask & IN_ISDIR)) {
+                offer(ev->name);
+            }
+            p += sizeof(inotify_event) + ev->len;
+        }
+    }
+}
+#endif
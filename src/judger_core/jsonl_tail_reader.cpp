@@ -0,0 +1,139 @@
+#include "seatui/judger/jsonl_tail_reader.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+struct FileIdentity {
+    int64_t file_id = 0;
+    int64_t size = 0;
+};
+
+// identity of the already opened handle, so a rename between open and stat cannot mix two files
+bool identityOf(FILE* f, FileIdentity& id) {
+#ifdef _WIN32
+    HANDLE h = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(f)));
+    BY_HANDLE_FILE_INFORMATION info{};
+    if (h == INVALID_HANDLE_VALUE || !GetFileInformationByHandle(h, &info)) return false;
+    id.file_id  = static_cast<int64_t>((static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow);
+    id.size     = static_cast<int64_t>((static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow);
+#else
+    struct stat st{};
+    if (fstat(fileno(f), &st) != 0) return false;
+    id.file_id = static_cast<int64_t>(st.st_ino);
+    id.size = static_cast<int64_t>(st.st_size);
+#endif
+    if (id.file_id == 0) id.file_id = 1;    // 0 is reserved for "never read"
+    return true;
+}
+
+bool seekTo(FILE* f, int64_t offset) {
+#ifdef _WIN32
+    return _fseeki64(f, offset, SEEK_SET) == 0;
+#else
+    return fseeko(f, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+// FNV-1a over the first min(len, kHeadBytes) bytes; 0 for an empty prefix
+int64_t headHash(FILE* f, int64_t len) {
+    char buf[JsonlTailReader::kHeadBytes];
+    size_t want = static_cast<size_t>(min<int64_t>(len, sizeof(buf)));
+    if (want == 0 || !seekTo(f, 0)) return 0;
+    size_t got = fread(buf, 1, want, f);
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < got; ++i) {
+        h ^= static_cast<unsigned char>(buf[i]);
+        h *= 1099511628211ULL;
+    }
+    return static_cast<int64_t>(h);
+}
+
+} // namespace
+
+JsonlTailReader::JsonlTailReader(size_t chunk_bytes, size_t max_bytes_per_call)
+    : chunk_bytes_(chunk_bytes > 0 ? chunk_bytes : (1 << 20)),
+      max_bytes_per_call_(max_bytes_per_call > 0 ? max_bytes_per_call : (8 << 20)) {}
+
+bool JsonlTailReader::readNewLines(const string& path, TailCheckpoint& cp, vector<string>& out_lines) {
+    has_more_ = false;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+
+    FileIdentity id;
+    if (!identityOf(f, id)) {
+        fclose(f);
+        return false;
+    }
+
+    if (cp.file_id != 0 && cp.file_id != id.file_id) {
+        cout << "[B] Info: " << path << " was rotated, reading from the start" << endl;
+        cp.offset = 0;
+    } else if (id.size < cp.offset) {
+        cout << "[B] Info: " << path << " was truncated (" << id.size << " < " << cp.offset << "), reading from the start" << endl;
+        cp.offset = 0;
+    } else if (cp.offset > 0 && headHash(f, cp.offset) != cp.head_hash) {
+        // same inode and long enough, but the bytes we already consumed changed: replaced or rewritten
+        cout << "[B] Info: " << path << " was rewritten, reading from the start" << endl;
+        cp.offset = 0;
+    }
+    cp.file_id = id.file_id;
+
+    if (id.size == cp.offset || !seekTo(f, cp.offset)) {
+        cp.head_hash = headHash(f, cp.offset);
+        fclose(f);
+        return true;
+    }
+
+    chunk_.resize(chunk_bytes_);
+    carry_.clear();
+    int64_t consumed = cp.offset;    // end of the last complete line seen so far
+    size_t bytes_read = 0;
+    size_t n = 0;
+    while ((n = fread(chunk_.data(), 1, chunk_.size(), f)) > 0) {
+        bytes_read += n;
+        const char* p = chunk_.data();
+        const char* end = p + n;
+        while (p < end) {
+            const char* nl = static_cast<const char*>(memchr(p, '\n', end - p));
+            if (!nl) {
+                carry_.append(p, end);
+                break;
+            }
+            size_t len = static_cast<size_t>(nl - p);
+            consumed += static_cast<int64_t>(carry_.size() + len + 1);
+            if (!carry_.empty()) {
+                carry_.append(p, len);
+                out_lines.push_back(std::move(carry_));
+                carry_.clear();
+            } else {
+                out_lines.emplace_back(p, len);
+            }
+            if (!out_lines.back().empty() && out_lines.back().back() == '\r') out_lines.back().pop_back();
+            if (out_lines.back().empty()) out_lines.pop_back();
+            p = nl + 1;
+        }
+        // stop at a chunk boundary once the budget is used, the next call resumes from consumed
+        if (bytes_read >= max_bytes_per_call_ && consumed > cp.offset) {
+            has_more_ = consumed < id.size;
+            break;
+        }
+    }
+    cp.offset = consumed;   // the partial tail in carry_ is re-read next time
+    cp.head_hash = headHash(f, cp.offset);
+    fclose(f);
+    carry_.clear();
+    return true;
+}
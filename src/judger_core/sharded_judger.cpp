@@ -0,0 +1,141 @@
+#include "seatui/judger/sharded_judger.hpp"
+#include "seatui/judger/seat_state_judger.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+ShardedJudger::ShardedJudger(int shards) {
+    const int n = max(1, shards);
+    shards_.reserve(n);
+    for (int s = 0; s < n; ++s) {
+        auto sh = make_unique<Shard>();
+        sh->judger = make_unique<SeatStateJudger>(nullptr);
+        sh->judger->setVerbose(false);
+        shards_.push_back(std::move(sh));
+    }
+    // a single shard runs inline on the caller's thread
+    if (n > 1) {
+        for (size_t s = 0; s < shards_.size(); ++s) shards_[s]->thread = thread(&ShardedJudger::shardLoop, this, s);
+    }
+}
+
+ShardedJudger::~ShardedJudger() {
+    {
+        lock_guard<mutex> lk(mtx_);
+        stop_ = true;
+    }
+    cv_work_.notify_all();
+    for (auto& sh : shards_) {
+        if (sh->thread.joinable()) sh->thread.join();
+    }
+}
+
+uint32_t ShardedJudger::shardOf(const string& seat_id, int shards) {
+    uint32_t h = 2166136261u;
+    for (unsigned char c : seat_id) {
+        h ^= c;
+        h *= 16777619u;
+    }
+    return shards > 0 ? h % static_cast<uint32_t>(shards) : 0;
+}
+
+uint32_t ShardedJudger::shardFor(const SeatObservation& obs) {
+    return shardFor(obs.seat_idx, obs.seat_id);
+}
+
+uint32_t ShardedJudger::shardFor(int32_t seat_idx, const string& seat_id) {
+    if (seat_idx < 0) return shardOf(seat_id, shardCount());
+    size_t idx = static_cast<size_t>(seat_idx);
+    if (idx >= shard_by_idx_.size()) shard_by_idx_.resize(idx + 1, -1);
+    if (shard_by_idx_[idx] < 0) shard_by_idx_[idx] = static_cast<int16_t>(shardOf(seat_id, shardCount()));
+    return static_cast<uint32_t>(shard_by_idx_[idx]);
+}
+
+SeatStateTable& ShardedJudger::stateFor(SeatIdx idx, const string& seat_id) {
+    SeatStateTable& table = shards_[shardFor(static_cast<int32_t>(idx), seat_id)]->judger->stateTable();
+    table.ensure(idx);
+    return table;
+}
+
+void ShardedJudger::setDebounce(const JudgerDebounceConfig& cfg) {
+    for (auto& sh : shards_) sh->judger->setDebounce(cfg);
+}
+
+void ShardedJudger::submit(const vector<SeatObservation>& frame) {
+    const uint32_t seq = static_cast<uint32_t>(frame_sizes_.size());
+    for (uint32_t pos = 0; pos < frame.size(); ++pos) {
+        Shard& sh = *shards_[shardFor(frame[pos])];
+        if (sh.work_count == sh.work.size()) sh.work.emplace_back();
+        WorkItem& w = sh.work[sh.work_count++];
+        w.frame_seq = seq;
+        w.pos = pos;
+        w.obs = frame[pos];
+    }
+    frame_sizes_.push_back(static_cast<uint32_t>(frame.size()));
+}
+
+void ShardedJudger::judgeShard(Shard& sh) {
+    if (sh.out.size() < sh.work_count) sh.out.resize(sh.work_count);
+    for (size_t i = 0; i < sh.work_count; ++i) {
+        const WorkItem& w = sh.work[i];
+        JudgedSeat& r = sh.out[i];
+        r.frame_seq = w.frame_seq;
+        r.pos = w.pos;
+        r.alerts.clear();
+        r.snapshot.reset();
+        r.event.reset();
+        sh.judger->judgeSeat(w.obs, r.state, r.alerts, r.snapshot, r.event);
+    }
+}
+
+void ShardedJudger::shardLoop(size_t s) {
+    uint64_t seen = 0;
+    Shard& sh = *shards_[s];
+    for (;;) {
+        {
+            unique_lock<mutex> lk(mtx_);
+            cv_work_.wait(lk, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+        judgeShard(sh);
+        {
+            lock_guard<mutex> lk(mtx_);
+            ++done_;
+        }
+        cv_done_.notify_one();
+    }
+}
+
+const vector<const JudgedSeat*>& ShardedJudger::flush() {
+    merged_.clear();
+    if (frame_sizes_.empty()) return merged_;
+
+    if (shards_.size() == 1) {
+        judgeShard(*shards_[0]);
+    } else {
+        {
+            lock_guard<mutex> lk(mtx_);
+            done_ = 0;
+            ++generation_;
+        }
+        cv_work_.notify_all();
+        unique_lock<mutex> lk(mtx_);
+        cv_done_.wait(lk, [&] { return done_ == shards_.size(); });
+    }
+
+    // deterministic merge: (frame_seq, pos) is dense, so every record has a fixed slot
+    vector<size_t> frame_base(frame_sizes_.size() + 1, 0);
+    for (size_t f = 0; f < frame_sizes_.size(); ++f) frame_base[f + 1] = frame_base[f] + frame_sizes_[f];
+    merged_.resize(frame_base.back());
+    for (auto& sh : shards_) {
+        for (size_t i = 0; i < sh->work_count; ++i) {
+            const JudgedSeat& r = sh->out[i];
+            merged_[frame_base[r.frame_seq] + r.pos] = &r;
+        }
+        sh->work_count = 0;
+    }
+    frame_sizes_.clear();
+    return merged_;
+}
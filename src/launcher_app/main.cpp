@@ -13,6 +13,7 @@
 
 #include <seatui/launcher/login_window.hpp>
 #include "ws/ws_hub.hpp"
+#include <seatui/db_seat_provider.hpp>
 
 // ===== 可选：如果你工程里有 VisionClient 的封装（按你提供的代码名）=====
 #include <seatui/vision/VisionClient.h>   // 如果你的头文件名不同，请改为实际入口
@@ -23,6 +24,7 @@
 #include "../db_core/SeatDatabase.h"
 // 可选：演示数据初始化
 #include "../db_core/DatabaseInitializer.h"
+#include "../db_core/SeatDbRetention.h"
 
 // ---------------- HiDPI 与全局样式 ----------------
 static void initHiDpi() {
@@ -64,6 +66,10 @@ static void applyGlobalStyle(QApplication& app) {
     app.setStyleSheet(qss);
 }
 
+// ---------------- Vision -> Judger 进程内交接队列 ----------------
+// Vision 每帧座位状态经 vision::Publisher 推入；Judger 阻塞等待，不再定时扫描 ../out
+static JudgerInputQueue g_judgerQueue;
+
 // ---------------- Vision 线程 ----------------
 class VisionThread : public QThread {
     Q_OBJECT
@@ -73,6 +79,11 @@ protected:
     void run() override {
         try {
             vision::VisionClient vc;
+            vc.setPublishCallback([](const std::vector<vision::SeatFrameState>& states) {
+                JudgerInput in;
+                in.states = states;
+                g_judgerQueue.push(std::move(in));
+            });
             qInfo() << "[VisionThread] 开始运行 VisionClient …";
             // 相对“运行目录/可执行文件”的上一级：
             // 最终运行时目录形如： .../build/.../Release/
@@ -102,9 +113,14 @@ protected:
     void run() override {
         try {
             SeatStateJudger judger;
+            // 去抖 / 迟滞: 只写确认后的状态变化 + 心跳快照; 驻留时间等见 assets/judger/judger.json
+            JudgerDebounceConfig debounce;
+            debounce.enable = true;   // 配置文件缺失时也开启, 使用默认驻留时间
+            loadDebounceConfig("../../assets/judger/judger.json", debounce);
+            judger.setDebounce(debounce);
             qInfo() << "[JudgerThread] 开始运行 SeatStateJudger …";
-            // 监听 ../out；内部是“无限循环扫描目录”的阻塞逻辑
-            judger.run("../../out");
+            // 阻塞消费 Vision 推送的帧队列；若改为文件交接，传 nullptr 则监听 ../out (inotify / 轮询兜底)
+            judger.run("../../out", &g_judgerQueue);
             qInfo() << "[JudgerThread] SeatStateJudger 结束";
         } catch (const std::exception& e) {
             qWarning() << "[JudgerThread] 异常:" << e.what();
@@ -147,10 +163,17 @@ int main(int argc, char *argv[]) {
             QMessageBox::critical(nullptr,"数据库错误","数据库初始化失败！"); return -1;
         }
 
+        // 座位表与分区：与 VisionClient 读同一份座位 JSON（相对运行目录）
+        DatabaseInitializer(db).importSeatsFromJson("../../assets/vision/config/demo_seats.json");
+
         // （可选）初始化演示数据：需要时解除注释
         // DatabaseInitializer init(db);
         // init.initializeSampleData();
 
+        // 后台保留策略: 快照降采样 / 过期删除 / incremental_vacuum (小批量, 不阻塞写入)
+        static SeatDbRetention retention(db);
+        retention.start();
+
         QMessageBox::information(nullptr, "启动状态", "3. 数据库初始化成功");
     } catch (const std::exception& e) {
         QMessageBox::critical(nullptr, "异常", QString("数据库异常: %1").arg(e.what())); return -1;
@@ -170,6 +193,9 @@ int main(int argc, char *argv[]) {
     } else {
         QMessageBox::information(nullptr, "启动状态", "5. WebSocket服务启动成功");
     }
+    // 分区占用：judger 写入时 DB 计数变化 → zoneUpdated → WS 推送 zone_update
+    static auto* seatProvider = new seatui::DbSeatProvider(SeatDatabase::getInstance(), &app);
+    QObject::connect(seatProvider, &seatui::ISeatProvider::zoneUpdated, wsHub, &WsHub::publishZone);
 
     // ==== 第四步：准备 out 目录 & 启动 Vision / Judger 线程 ====
     // out 目录与之前“独立 main”的代码保持完全一致
@@ -180,7 +206,7 @@ int main(int argc, char *argv[]) {
     auto* visionThread = new VisionThread(&app);
     auto* judgerThread = new JudgerThread(&app);
     visionThread->start();  // 非阻塞
-    judgerThread->start();  // 非阻塞（内部为阻塞轮询）
+    judgerThread->start();  // 非阻塞（内部阻塞等待队列）
 
     // ==== 第五步：一次创建两个“登录窗口” ====
     QMessageBox::information(nullptr, "启动状态", "6. 创建登录窗口...");
@@ -66,6 +66,33 @@ VisionConfig VisionConfig::fromYaml(const std::string& yaml_path) {
         try_get(r, "enable_async_snapshot", c.enable_async_snapshot);
         try_get(r, "yolo_variant", c.yolo_variant);
         try_get(r, "use_single_multiclass_model", c.use_single_multiclass_model);
+
+        try_get(r, "tracker_enable",        c.tracker_enable);
+        try_get(r, "detect_every_k_frames", c.detect_every_k_frames);
+        try_get(r, "tracker_iou_match",     c.tracker_iou_match);
+        try_get(r, "tracker_high_conf",     c.tracker_high_conf);
+        try_get(r, "tracker_max_age",       c.tracker_max_age);
+        try_get(r, "tracker_min_hits",      c.tracker_min_hits);
+
+        try_get(r, "occupancy_backend",   c.occupancy_backend);
+        try_get(r, "seat_cls_model_path", c.seat_cls_model_path);
+        try_get(r, "seat_cls_input_w",    c.seat_cls_input_w);
+        try_get(r, "seat_cls_input_h",    c.seat_cls_input_h);
+        try_get(r, "seat_cls_output",     c.seat_cls_output);
+
+        try_get(r, "dirty_seat_enable",         c.dirty_seat_enable);
+        try_get(r, "dirty_seat_thumb",          c.dirty_seat_thumb);
+        try_get(r, "dirty_seat_mean_delta",     c.dirty_seat_mean_delta);
+        try_get(r, "dirty_seat_std_delta",      c.dirty_seat_std_delta);
+        try_get(r, "dirty_seat_refresh_frames", c.dirty_seat_refresh_frames);
+
+        try_get(r, "frame_dedup_enable",   c.frame_dedup_enable);
+        try_get(r, "frame_dedup_hamming",  c.frame_dedup_hamming);
+        try_get(r, "frame_dedup_max_skip", c.frame_dedup_max_skip);
+
+        try_get(r, "ingest_workers",        c.ingest_workers);
+        try_get(r, "ingest_max_in_flight",  c.ingest_max_in_flight);
+        try_get(r, "ingest_reduced_decode", c.ingest_reduced_decode);
     } catch (...) {
         // keep defaults
     }
@@ -122,6 +149,33 @@ VisionConfig VisionConfig::fromJson(const std::string& json_path) {
         get_b("enable_async_snapshot", c.enable_async_snapshot);
         get_s("yolo_variant", c.yolo_variant);
         get_b("use_single_multiclass_model", c.use_single_multiclass_model);
+
+        get_b("tracker_enable", c.tracker_enable);
+        get_i("detect_every_k_frames", c.detect_every_k_frames);
+        get_f("tracker_iou_match", c.tracker_iou_match);
+        get_f("tracker_high_conf", c.tracker_high_conf);
+        get_i("tracker_max_age", c.tracker_max_age);
+        get_i("tracker_min_hits", c.tracker_min_hits);
+
+        get_s("occupancy_backend", c.occupancy_backend);
+        get_s("seat_cls_model_path", c.seat_cls_model_path);
+        get_i("seat_cls_input_w", c.seat_cls_input_w);
+        get_i("seat_cls_input_h", c.seat_cls_input_h);
+        get_s("seat_cls_output", c.seat_cls_output);
+
+        get_b("dirty_seat_enable", c.dirty_seat_enable);
+        get_i("dirty_seat_thumb", c.dirty_seat_thumb);
+        get_f("dirty_seat_mean_delta", c.dirty_seat_mean_delta);
+        get_f("dirty_seat_std_delta", c.dirty_seat_std_delta);
+        get_i("dirty_seat_refresh_frames", c.dirty_seat_refresh_frames);
+
+        get_b("frame_dedup_enable", c.frame_dedup_enable);
+        get_i("frame_dedup_hamming", c.frame_dedup_hamming);
+        get_i("frame_dedup_max_skip", c.frame_dedup_max_skip);
+
+        get_i("ingest_workers", c.ingest_workers);
+        get_i("ingest_max_in_flight", c.ingest_max_in_flight);
+        get_b("ingest_reduced_decode", c.ingest_reduced_decode);
     } catch (...) {
         // keep defaults
     }
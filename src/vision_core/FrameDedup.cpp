@@ -0,0 +1,52 @@
+#include "seatui/vision/FrameDedup.h"
+#include <opencv2/imgproc.hpp>
+
+namespace vision {
+
+uint64_t FrameDeduper::dHash64(const cv::Mat& bgr) {
+    cv::Mat gray, small;
+    if (bgr.channels() == 3)      cv::cvtColor(bgr, gray, cv::COLOR_BGR2GRAY);
+    else if (bgr.channels() == 4) cv::cvtColor(bgr, gray, cv::COLOR_BGRA2GRAY);
+    else                          gray = bgr;
+    cv::resize(gray, small, cv::Size(9, 8), 0, 0, cv::INTER_AREA);
+
+    uint64_t h = 0;
+    for (int r = 0; r < 8; ++r) {
+        const uchar* row = small.ptr<uchar>(r);
+        for (int c = 0; c < 8; ++c) {
+            h = (h << 1) | (row[c] > row[c + 1] ? 1u : 0u);
+        }
+    }
+    return h;
+}
+
+int FrameDeduper::hamming(uint64_t a, uint64_t b) {
+    uint64_t x = a ^ b;
+    int n = 0;
+    while (x) { x &= x - 1; ++n; }
+    return n;
+}
+
+bool FrameDeduper::isNearDuplicate(const cv::Mat& bgr, int64_t frame_index) {
+    if (bgr.empty()) return false;
+    ++stats_.frames_checked;
+
+    uint64_t h = dHash64(bgr);
+    if (has_ref_) {
+        stats_.last_distance = hamming(h, ref_hash_);
+        bool force = max_skip_ > 0 && consecutive_skips_ >= max_skip_;
+        if (stats_.last_distance <= hamming_thres_ && !force) {
+            ++consecutive_skips_;
+            ++stats_.frames_suppressed;
+            return true;
+        }
+    }
+
+    has_ref_ = true;
+    ref_hash_ = h;
+    consecutive_skips_ = 0;
+    stats_.last_processed_frame_index = frame_index;
+    return false;
+}
+
+} // namespace vision
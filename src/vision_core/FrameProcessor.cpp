@@ -19,6 +19,7 @@
 #include "seatui/vision/OrtYolo.h"
 #include "seatui/vision/Mog2.h"
 #include "seatui/vision/Snapshotter.h"
+#include "seatui/vision/ImageIngest.h"
 
 namespace fs = std::filesystem;
 
@@ -62,6 +63,24 @@ bool FrameProcessor::onFrame(
     // report onFrame
     std::cout << "[FrameProcessor] onFrame called for frame index: " << frame_index << ". Start processing..." << "\n";
 
+    // 帧座位状态记录目录: 配置的 states_output 所在目录 (latest_frame_file 与之同目录)
+    const std::string out_dir = std::filesystem::path(latest_frame_file).parent_path().string();
+
+    // 近重复帧抑制: 跳过整条流水线, 只写 "unchanged" 心跳记录; latest_frame_file 保留上一处理帧的完整状态
+    if (vision.isNearDuplicate(bgr, frame_index)) {
+        vision.publishUnchanged(now_ms, frame_index);   // 进程内下游 (judger) 同样收到本帧, 沿用上一帧状态
+        FrameDedupStats st = vision.dedupStats();
+        std::string line = frameHeartbeatToJsonLine(now_ms, frame_index, st.last_processed_frame_index,
+                                                    input_path.string(), st.last_distance, st.frames_suppressed);
+        std::ofstream current_ofs(getFrameJsonlPath(out_dir, frame_index), std::ios::trunc);
+        if (current_ofs) current_ofs << line << "\n";
+        std::cout << "[FrameProcessor] Frame " << frame_index << " unchanged (hamming = " << st.last_distance
+                  << ", ref = " << st.last_processed_frame_index << "), suppressed "
+                  << st.frames_suppressed << " / " << st.frames_checked << " frames\n\n";
+        ++processed;
+        return true;
+    }
+
     // process frame
     auto states = vision.processFrame(bgr, now_ms, frame_index++);
 
@@ -95,9 +114,9 @@ bool FrameProcessor::onFrame(
             if (latest_frame_ofs) latest_frame_ofs << line << "\n";
         }
     } else {  // works as method called in Library_System repo
-        // 由于现在只需要固定路径写入帧座位状态记录，不需入库图像，因此此处仅进行帧座位状态记录。固定路径为 ./out/000000.jsonl
+        // 由于现在只需要固定路径写入帧座位状态记录，不需入库图像，因此此处仅进行帧座位状态记录。路径为 <out_dir>/000000.jsonl
         std::string line = seatFrameStatesToJsonLine(states, ts, frame_index - 1, input_path.string(), "");
-        std::string current_frame_jsonl_ofs_path = getFrameJsonlPath("../../out", frame_index - 1);
+        std::string current_frame_jsonl_ofs_path = getFrameJsonlPath(out_dir, frame_index - 1);
         // 写入策略：若文件已存在且非空，则覆写（truncate）；否则追加（append）
         std::ios::openmode write_mode = std::ios::app;
         try {
@@ -512,6 +531,12 @@ size_t FrameProcessor::imageProcess(
         return 0;
     }
     
+    // 并行读入模式
+    if (cfg.ingest_workers > 0) {
+        return imageProcessParallel(image_path, latest_frame_dir, ofs, cfg, vision,
+                                    max_process_frames, sample_fp100, original_total_frames);
+    }
+
     std::cout << "[FrameProcessor] Image directory mode. Iterating files...\n";
     
     // iteration on the imgs (y no sampling here? needed!!! )
@@ -577,8 +602,7 @@ size_t FrameProcessor::imageProcess(
                 total_processed
             );
             
-            ++frame_index;
-            ++total_processed;
+            ++frame_index;                      // total_processed 已由 onFrame 累加
             
             // report success in processing current image! 
             std::cout << "[FrameProcessor] Processed image: " << entry.path().string() << ", total processed: " << total_processed << "\n";
@@ -607,6 +631,106 @@ size_t FrameProcessor::imageProcess(
     return total_processed;
 } 
 
+/* imageProcessParallel
+* 并行解码的批量图像处理: 排序文件列表 -> N 线程 imread -> 重排缓冲 -> 按序 onFrame
+*  - 采样与 frame_index 规则与串行 imageProcess 相同
+*  - 原图长边为模型输入 2/4 倍以上时使用 IMREAD_REDUCED_COLOR_2/4 解码, 再 resize 回原尺寸,
+*    这样 seats.json 中的像素坐标无需换算
+*/
+size_t FrameProcessor::imageProcessParallel(
+    const std::string& image_path,
+    const std::string& latest_frame_dir,
+    std::ofstream& ofs,
+    const vision::VisionConfig& cfg,
+    VisionA& vision,
+    size_t max_process_frames,
+    int sample_fp100,
+    int original_total_frames
+) {
+    size_t total_processed = 0;
+    size_t total_errors = 0;
+    int frame_index = 0;
+    const std::string annotated_frames_dir = !cfg.annotated_frames_dir.empty() ? cfg.annotated_frames_dir : "../../data/annotated_frames";
+    const std::string latest_frame_file = (std::filesystem::path(latest_frame_dir) / "last_frame.jsonl").string();
+
+    // 排序后的确定性文件列表 + 采样
+    std::vector<std::filesystem::path> all_files = ParallelImageReader::listImageFiles(image_path);
+    size_t total_frames = (original_total_frames > 0) ? original_total_frames : all_files.size();
+    int sample_stepsize = std::max(1, getStepsize(total_frames, sample_fp100));
+    std::vector<std::filesystem::path> files;
+    for (size_t i = 0; i < all_files.size() && files.size() < max_process_frames; i += sample_stepsize) {
+        files.push_back(all_files[i]);
+    }
+    if (files.empty()) {
+        std::cout << "[FrameProcessor] imageProcessParallel: no images in " << image_path << "\n";
+        return 0;
+    }
+
+    // 以首帧尺寸决定是否降采样解码 (同一目录的抽帧尺寸一致)
+    int imread_flags = cv::IMREAD_COLOR;
+    cv::Size original_size;
+    if (cfg.ingest_reduced_decode) {
+        cv::Mat probe = cv::imread(files.front().string());
+        if (!probe.empty()) {
+            original_size = probe.size();
+            imread_flags = ParallelImageReader::chooseReducedFlag(original_size, std::max(cfg.input_w, cfg.input_h));
+        }
+    }
+
+    std::cout << "[FrameProcessor] Image directory mode (parallel). files=" << files.size()
+              << ", workers=" << cfg.ingest_workers
+              << ", reduced_decode=" << (imread_flags == cv::IMREAD_REDUCED_COLOR_4 ? "1/4"
+                                       : imread_flags == cv::IMREAD_REDUCED_COLOR_2 ? "1/2" : "off") << "\n";
+
+    ParallelImageReader reader(files, cfg.ingest_workers, cfg.ingest_max_in_flight, imread_flags,
+                               imread_flags == cv::IMREAD_COLOR ? cv::Size() : original_size);
+
+    size_t idx = 0;
+    cv::Mat bgr;
+    while (reader.next(idx, bgr)) {
+        if (bgr.empty()) {
+            std::cerr << "[FrameProcessor][diag] imread empty: " << files[idx].string() << "\n";
+        }
+        try {
+            int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+
+            bool continue_process = FrameProcessor::onFrame(
+                frame_index,
+                bgr,
+                0.0,  // t_sec
+                now_ms,
+                files[idx],
+                annotated_frames_dir,
+                ofs,
+                vision,
+                latest_frame_file,
+                total_processed
+            );
+            ++frame_index;
+
+            if (!continue_process || total_processed >= max_process_frames) {
+                std::cout << "[FrameProcessor] Stopping at frame " << frame_index << " (" << files[idx].string() << ")\n";
+                reader.stop();
+                break;
+            }
+        } catch (const std::exception &exception) {
+            ++total_errors;
+            std::cerr << "[FrameProcessor] Frame error: " << exception.what() << " src=" << files[idx].string() << "\n";
+        } catch (...) {
+            ++total_errors;
+            std::cerr << "[FrameProcessor] Frame error: unknown src=" << files[idx].string() << "\n";
+        }
+    }
+
+    std::cout << "[FrameProcessor] imageProcessParallel completed: processed=" << total_processed << "\n                 "
+              << "errors=" << total_errors << "\n                 "
+              << "original total frames=" << total_frames << "\n                 "
+              << "stepsize to process the images: " << sample_stepsize << "\n";
+
+    return total_processed;
+}
+
 // ==================== Utils: Sampling, Counting, and Mapping ===========================
 
 static double safe_fps(cv::VideoCapture& cap) {
@@ -0,0 +1,109 @@
+#include "seatui/vision/ImageIngest.h"
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <iostream>
+
+namespace vision {
+
+ParallelImageReader::ParallelImageReader(std::vector<std::filesystem::path> files,
+                                         int workers,
+                                         int max_in_flight,
+                                         int imread_flags,
+                                         cv::Size restore_size)
+    : files_(std::move(files)),
+      max_in_flight_(std::max(1, max_in_flight)),
+      imread_flags_(imread_flags),
+      restore_size_(restore_size)
+{
+    int n = std::max(1, workers);
+    workers_.reserve(n);
+    for (int i = 0; i < n; ++i) workers_.emplace_back(&ParallelImageReader::workerLoop, this);
+}
+
+ParallelImageReader::~ParallelImageReader() {
+    stop();
+    for (auto& t : workers_) if (t.joinable()) t.join();
+}
+
+void ParallelImageReader::stop() {
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        stopped_ = true;
+    }
+    cv_space_.notify_all();
+    cv_ready_.notify_all();
+}
+
+void ParallelImageReader::workerLoop() {
+    for (;;) {
+        size_t idx = next_claim_.fetch_add(1);
+        if (idx >= files_.size()) return;
+
+        // 等待解码窗口: 领先交付位置太多时阻塞
+        {
+            std::unique_lock<std::mutex> lk(mtx_);
+            cv_space_.wait(lk, [&] { return stopped_ || idx < next_out_ + static_cast<size_t>(max_in_flight_); });
+            if (stopped_) return;
+        }
+
+        cv::Mat img;
+        try {
+            img = cv::imread(files_[idx].string(), imread_flags_);
+            if (!img.empty() && restore_size_.width > 0 && restore_size_.height > 0 && img.size() != restore_size_) {
+                cv::Mat full;
+                cv::resize(img, full, restore_size_, 0, 0, cv::INTER_LINEAR);
+                img = full;
+            }
+        } catch (const std::exception& ex) {
+            std::cerr << "[ParallelImageReader] imread exception: " << files_[idx].string() << " : " << ex.what() << "\n";
+            img.release();
+        }
+
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            reorder_.emplace(idx, std::move(img));
+        }
+        cv_ready_.notify_all();
+    }
+}
+
+bool ParallelImageReader::next(size_t& index, cv::Mat& out) {
+    std::unique_lock<std::mutex> lk(mtx_);
+    if (next_out_ >= files_.size()) return false;
+    cv_ready_.wait(lk, [&] { return stopped_ || reorder_.count(next_out_) > 0; });
+    if (stopped_) return false;
+
+    auto it = reorder_.find(next_out_);
+    index = it->first;
+    out = std::move(it->second);
+    reorder_.erase(it);
+    ++next_out_;
+    lk.unlock();
+    cv_space_.notify_all();
+    return true;
+}
+
+std::vector<std::filesystem::path> ParallelImageReader::listImageFiles(const std::string& dir) {
+    std::vector<std::filesystem::path> files;
+    std::error_code error_code;
+    for (auto& entry : std::filesystem::directory_iterator(dir, error_code)) {
+        if (error_code) break;
+        if (!entry.is_regular_file()) continue;
+        auto ext = entry.path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        if (ext == ".jpg" || ext == ".jpeg" || ext == ".png") files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+int ParallelImageReader::chooseReducedFlag(cv::Size original, int target_long_side) {
+    const int long_side = std::max(original.width, original.height);
+    if (target_long_side <= 0 || long_side <= 0) return cv::IMREAD_COLOR;
+    if (long_side / 4 >= target_long_side) return cv::IMREAD_REDUCED_COLOR_4;
+    if (long_side / 2 >= target_long_side) return cv::IMREAD_REDUCED_COLOR_2;
+    return cv::IMREAD_COLOR;
+}
+
+} // namespace vision
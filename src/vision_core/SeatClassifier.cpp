@@ -0,0 +1,135 @@
+#include "seatui/vision/SeatClassifier.h"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace vision {
+
+    OrtSeatClassifier::OrtSeatClassifier(const SessionOptions& opt)
+        : opt_(opt),
+          env_(ORT_LOGGING_LEVEL_WARNING, "SeatCls"),
+          session_options_()
+    {
+        if (opt_.fake_infer) {
+            ready_ = true;
+            return;
+        }
+
+        session_options_.SetIntraOpNumThreads(opt_.intra_threads);
+        try {
+#ifdef _WIN32
+            std::wstring model_path_w(opt_.model_path.begin(), opt_.model_path.end());
+            session_ = std::make_unique<Ort::Session>(env_, model_path_w.c_str(), session_options_);
+#else
+            session_ = std::make_unique<Ort::Session>(env_, opt_.model_path.c_str(), session_options_);
+#endif
+            Ort::AllocatorWithDefaultOptions allocator;
+            input_name_  = session_->GetInputNameAllocated(0, allocator).get();
+            output_name_ = session_->GetOutputNameAllocated(0, allocator).get();
+            auto in_shape = session_->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+            if (!in_shape.empty()) model_batch_ = in_shape[0];
+            ready_ = true;
+            std::cout << "[OrtSeatClassifier] ONNX session created with model: " << opt_.model_path
+                      << " (batch=" << (model_batch_ > 0 ? std::to_string(model_batch_) : std::string("dynamic")) << ")\n";
+        } catch (const std::exception& ex) {
+            std::cerr << "[OrtSeatClassifier] Failed to create ONNX session: " << ex.what() << "\n";
+            ready_ = false;
+        }
+    }
+
+    std::vector<SeatClsResult> OrtSeatClassifier::classify(const std::vector<cv::Mat>& crops) {
+        std::vector<SeatClsResult> out(crops.size());
+        if (crops.empty() || !ready_) return out;
+
+        // ========= fake infer: 随机类别, 仅用于无模型时打通流程 ===========
+        if (opt_.fake_infer) {
+            static std::mt19937 gen{321};
+            std::uniform_int_distribution<int> ui(0, 2);
+            for (auto& r : out) {
+                r.state = static_cast<SeatOccupancyState>(ui(gen));
+                r.conf = 1.f;
+            }
+            return out;
+        }
+
+        // 固定 batch 的模型按模型 batch 分块，动态 batch 一次跑完
+        const size_t chunk = model_batch_ > 0 ? static_cast<size_t>(model_batch_) : crops.size();
+        for (size_t begin = 0; begin < crops.size(); begin += chunk) {
+            size_t count = std::min(chunk, crops.size() - begin);
+            try {
+                runBatch(crops, begin, count, out);
+            } catch (const std::exception& ex) {
+                // 该分块无结论: 已写入的部分结果也作废, 座位保持 UNKNOWN
+                for (size_t n = begin; n < begin + count; ++n) out[n] = SeatClsResult{};
+                static bool warned = false;
+                if (!warned) {
+                    std::cerr << "[OrtSeatClassifier] infer exception: " << ex.what() << "\n";
+                    warned = true;
+                }
+            }
+        }
+        return out;
+    }
+
+    void OrtSeatClassifier::runBatch(const std::vector<cv::Mat>& crops, size_t begin, size_t count,
+                                     std::vector<SeatClsResult>& out) {
+        const int W = opt_.input_w, H = opt_.input_h;
+        const size_t plane = static_cast<size_t>(W) * H;
+        // 固定 batch 模型最后一块不足时以 0 填充
+        const size_t batch = model_batch_ > 0 ? static_cast<size_t>(model_batch_) : count;
+        input_buf_.assign(batch * 3 * plane, 0.f);
+
+        // 预处理: resize -> BGR2RGB -> NCHW, [0,1] 归一化
+        cv::Mat resized, rgb;
+        for (size_t n = 0; n < count; ++n) {
+            const cv::Mat& crop = crops[begin + n];
+            if (crop.empty()) continue;
+            cv::resize(crop, resized, cv::Size(W, H), 0, 0, cv::INTER_AREA);
+            cv::cvtColor(resized, rgb, cv::COLOR_BGR2RGB);
+            float* dst = input_buf_.data() + n * 3 * plane;
+            for (int h = 0; h < H; ++h) {
+                const cv::Vec3b* row = rgb.ptr<cv::Vec3b>(h);
+                for (int w = 0; w < W; ++w) {
+                    size_t idx = static_cast<size_t>(h) * W + w;
+                    dst[idx]             = row[w][0] / 255.0f;
+                    dst[plane + idx]     = row[w][1] / 255.0f;
+                    dst[2 * plane + idx] = row[w][2] / 255.0f;
+                }
+            }
+        }
+
+        std::vector<int64_t> input_shape = {static_cast<int64_t>(batch), 3, H, W};
+        Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+        Ort::Value input_tensor = Ort::Value::CreateTensor<float>(
+            memory_info, input_buf_.data(), input_buf_.size(), input_shape.data(), input_shape.size());
+
+        const char* in_names[]  = { input_name_.c_str() };
+        const char* out_names[] = { output_name_.c_str() };
+        auto outputs = session_->Run(Ort::RunOptions{nullptr}, in_names, &input_tensor, 1, out_names, 1);
+
+        const float* logits = outputs[0].GetTensorData<float>();
+        auto out_shape = outputs[0].GetTensorTypeAndShapeInfo().GetShape();
+        const int num_classes = static_cast<int>(out_shape.size() >= 2 ? out_shape[1] : 0);
+        if (num_classes <= 0) return;
+
+        // 后处理: argmax (+ logits 时 softmax), 类别下标直接映射到 SeatOccupancyState
+        for (size_t n = 0; n < count; ++n) {
+            const float* row = logits + n * num_classes;
+            int best = static_cast<int>(std::max_element(row, row + num_classes) - row);
+            SeatClsResult& r = out[begin + n];
+            if (opt_.output_probs) {
+                r.conf = row[best];
+            } else {
+                float denom = 0.f;
+                for (int c = 0; c < num_classes; ++c) denom += std::exp(row[c] - row[best]);
+                r.conf = denom > 0.f ? 1.f / denom : 0.f;
+            }
+            r.state = best <= static_cast<int>(SeatOccupancyState::PERSON_AND_OBJECT)
+                          ? static_cast<SeatOccupancyState>(best)
+                          : SeatOccupancyState::UNKNOWN;
+        }
+    }
+
+} // namespace vision
@@ -0,0 +1,183 @@
+#include "seatui/vision/Tracker.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vision {
+
+// 简易 IoU (与 Nms.cpp 中一致)
+static float iouRect(const cv::Rect& a, const cv::Rect& b) {
+    int inter_x = std::max(a.x, b.x);
+    int inter_y = std::max(a.y, b.y);
+    int inter_w = std::min(a.x + a.width, b.x + b.width) - inter_x;
+    int inter_h = std::min(a.y + a.height, b.y + b.height) - inter_y;
+    if (inter_w <= 0 || inter_h <= 0) return 0.f;
+    float inter = static_cast<float>(inter_w * inter_h);
+    float ua = static_cast<float>(a.width * a.height + b.width * b.height) - inter;
+    return ua <= 0 ? 0.f : inter / ua;
+}
+
+MultiObjectTracker::MultiObjectTracker(const TrackerConfig& cfg)
+    : cfg_(cfg) {}
+
+void MultiObjectTracker::reset() {
+    tracks_.clear();
+}
+
+// 新建轨迹: 8 维状态 [cx,cy,w,h,vx,vy,vw,vh], 4 维观测 [cx,cy,w,h], 帧间隔视为 1
+void MultiObjectTracker::initTrack(Track& t, const BBox& det) {
+    t.track_id = next_id_++;
+    t.cls_id   = det.cls_id;
+    t.cls_name = det.cls_name;
+    t.conf     = det.conf;
+    t.hits     = 1;
+    t.misses   = 0;
+    t.rect     = det.rect;
+
+    t.kf.init(8, 4, 0, CV_32F);
+    t.kf.transitionMatrix = cv::Mat::eye(8, 8, CV_32F);
+    for (int i = 0; i < 4; ++i) t.kf.transitionMatrix.at<float>(i, i + 4) = 1.f;
+    t.kf.measurementMatrix = cv::Mat::zeros(4, 8, CV_32F);
+    for (int i = 0; i < 4; ++i) t.kf.measurementMatrix.at<float>(i, i) = 1.f;
+
+    cv::setIdentity(t.kf.processNoiseCov, cv::Scalar(1e-2));
+    for (int i = 4; i < 8; ++i) t.kf.processNoiseCov.at<float>(i, i) = 1e-3f; // 速度变化更平滑
+    cv::setIdentity(t.kf.measurementNoiseCov, cv::Scalar(1e-1));
+    cv::setIdentity(t.kf.errorCovPost, cv::Scalar(10));
+    for (int i = 4; i < 8; ++i) t.kf.errorCovPost.at<float>(i, i) = 1e3f;     // 初始速度未知
+
+    t.kf.statePost = cv::Mat::zeros(8, 1, CV_32F);
+    t.kf.statePost.at<float>(0) = det.rect.x + det.rect.width  * 0.5f;
+    t.kf.statePost.at<float>(1) = det.rect.y + det.rect.height * 0.5f;
+    t.kf.statePost.at<float>(2) = static_cast<float>(det.rect.width);
+    t.kf.statePost.at<float>(3) = static_cast<float>(det.rect.height);
+}
+
+// 推进一步并返回预测框
+cv::Rect MultiObjectTracker::stepPredict(Track& t) {
+    const cv::Mat& s = t.kf.predict();
+    float cx = s.at<float>(0), cy = s.at<float>(1);
+    float w  = std::max(1.f, s.at<float>(2));
+    float h  = std::max(1.f, s.at<float>(3));
+    t.rect = cv::Rect(static_cast<int>(std::lround(cx - w * 0.5f)),
+                      static_cast<int>(std::lround(cy - h * 0.5f)),
+                      static_cast<int>(std::lround(w)),
+                      static_cast<int>(std::lround(h)));
+    return t.rect;
+}
+
+void MultiObjectTracker::correct(Track& t, const BBox& det) {
+    cv::Mat meas(4, 1, CV_32F);
+    meas.at<float>(0) = det.rect.x + det.rect.width  * 0.5f;
+    meas.at<float>(1) = det.rect.y + det.rect.height * 0.5f;
+    meas.at<float>(2) = static_cast<float>(det.rect.width);
+    meas.at<float>(3) = static_cast<float>(det.rect.height);
+    t.kf.correct(meas);
+    t.rect = det.rect;
+    t.conf = det.conf;
+    t.hits += 1;
+    t.misses = 0;
+}
+
+std::vector<std::pair<int, int>> MultiObjectTracker::associate(
+    const std::vector<int>& track_idx,
+    const std::vector<int>& det_idx,
+    const std::vector<BBox>& detections) const
+{
+    // 候选对按 IoU 降序贪心匹配 (座位场景目标少, 无需匈牙利算法)
+    struct Cand { float iou; int t; int d; };
+    std::vector<Cand> cands;
+    for (int ti : track_idx) {
+        for (int di : det_idx) {
+            if (tracks_[ti].cls_id != detections[di].cls_id) continue;
+            float iou = iouRect(tracks_[ti].rect, detections[di].rect);
+            if (iou >= cfg_.iou_match) cands.push_back({iou, ti, di});
+        }
+    }
+    std::sort(cands.begin(), cands.end(), [](const Cand& a, const Cand& b) { return a.iou > b.iou; });
+
+    std::vector<std::pair<int, int>> matches;
+    std::vector<bool> t_used(tracks_.size(), false), d_used(detections.size(), false);
+    for (auto& c : cands) {
+        if (t_used[c.t] || d_used[c.d]) continue;
+        t_used[c.t] = d_used[c.d] = true;
+        matches.emplace_back(c.t, c.d);
+    }
+    return matches;
+}
+
+void MultiObjectTracker::prune() {
+    tracks_.erase(std::remove_if(tracks_.begin(), tracks_.end(),
+                                 [this](const Track& t) { return t.misses > cfg_.max_age; }),
+                  tracks_.end());
+}
+
+std::vector<BBox> MultiObjectTracker::update(const std::vector<BBox>& detections) {
+    // 1. 所有轨迹先预测到当前帧
+    for (auto& t : tracks_) stepPredict(t);
+
+    // 2. 高/低分检测分组
+    std::vector<int> high, low;
+    for (int i = 0; i < static_cast<int>(detections.size()); ++i) {
+        (detections[i].conf >= cfg_.high_conf ? high : low).push_back(i);
+    }
+
+    std::vector<BBox> out = detections;   // 输出保持检测框本身, 仅补 track_id
+    std::vector<bool> t_matched(tracks_.size(), false);
+
+    // 3. 第一轮: 全部轨迹 x 高分框
+    std::vector<int> all_tracks(tracks_.size());
+    for (int i = 0; i < static_cast<int>(tracks_.size()); ++i) all_tracks[i] = i;
+    std::vector<bool> d_matched(detections.size(), false);
+    for (auto& m : associate(all_tracks, high, detections)) {
+        correct(tracks_[m.first], detections[m.second]);
+        out[m.second].track_id = tracks_[m.first].track_id;
+        t_matched[m.first] = true;
+        d_matched[m.second] = true;
+    }
+
+    // 4. 第二轮: 剩余轨迹 x 低分框 (遮挡/低头时分数下降, 仍可延续身份)
+    std::vector<int> rest_tracks;
+    for (int i = 0; i < static_cast<int>(tracks_.size()); ++i) if (!t_matched[i]) rest_tracks.push_back(i);
+    for (auto& m : associate(rest_tracks, low, detections)) {
+        correct(tracks_[m.first], detections[m.second]);
+        out[m.second].track_id = tracks_[m.first].track_id;
+        t_matched[m.first] = true;
+        d_matched[m.second] = true;
+    }
+
+    // 5. 未命中的轨迹累计 misses
+    for (size_t i = 0; i < t_matched.size(); ++i) if (!t_matched[i]) tracks_[i].misses += 1;
+
+    // 6. 未关联的高分框新建轨迹
+    for (int di : high) {
+        if (d_matched[di]) continue;
+        Track t;
+        initTrack(t, detections[di]);
+        out[di].track_id = t.track_id;
+        tracks_.push_back(std::move(t));
+    }
+
+    prune();
+    return out;
+}
+
+std::vector<BBox> MultiObjectTracker::predict() {
+    std::vector<BBox> out;
+    out.reserve(tracks_.size());
+    for (auto& t : tracks_) {
+        stepPredict(t);
+        t.misses += 1;
+        if (t.hits < cfg_.min_hits || t.misses > cfg_.max_age) continue;
+        BBox b;
+        b.rect     = t.rect;
+        b.conf     = t.conf;
+        b.cls_id   = t.cls_id;
+        b.cls_name = t.cls_name;
+        b.track_id = t.track_id;
+        out.push_back(std::move(b));
+    }
+    prune();
+    return out;
+}
+
+} // namespace vision
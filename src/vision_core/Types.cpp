@@ -19,6 +19,7 @@ std::string seatFrameStatesToJson(const std::vector<SeatFrameState>& states) {
         o["object_count"] = s.object_count;
         o["occupancy_state"] = toString(s.occupancy_state);
         o["snapshot_path"] = s.snapshot_path;
+        o["carried_forward"] = s.carried_forward;
         j.push_back(o);
     }
     return j.dump();
@@ -53,6 +54,7 @@ std::string seatFrameStatesToJsonLine(
         o["object_count"] = s.object_count;
         o["occupancy_state"] = toString(s.occupancy_state);
         o["snapshot_path"] = s.snapshot_path;
+        o["carried_forward"] = s.carried_forward;
 
         // ROI
         o["seat_roi"] = {
@@ -72,7 +74,8 @@ std::string seatFrameStatesToJsonLine(
             pboxes.push_back({
                 {"x", b.rect.x}, {"y", b.rect.y},
                 {"w", b.rect.width}, {"h", b.rect.height},
-                {"conf", b.conf}, {"cls_id", b.cls_id}, {"cls_name", b.cls_name}
+                {"conf", b.conf}, {"cls_id", b.cls_id}, {"cls_name", b.cls_name},
+                {"track_id", b.track_id}
             });
         }
         nlohmann::json oboxes = nlohmann::json::array();
@@ -80,7 +83,8 @@ std::string seatFrameStatesToJsonLine(
             oboxes.push_back({
                 {"x", b.rect.x}, {"y", b.rect.y},
                 {"w", b.rect.width}, {"h", b.rect.height},
-                {"conf", b.conf}, {"cls_id", b.cls_id}, {"cls_name", b.cls_name}
+                {"conf", b.conf}, {"cls_id", b.cls_id}, {"cls_name", b.cls_name},
+                {"track_id", b.track_id}
             });
         }
         o["person_boxes"] = std::move(pboxes);
@@ -97,6 +101,25 @@ std::string seatFrameStatesToJsonLine(
     return root.dump();
 }
 
+std::string frameHeartbeatToJsonLine(
+    int64_t ts_ms,
+    int64_t frame_index,
+    int64_t ref_frame_index,
+    const std::string& image_path,
+    int hamming_distance,
+    int64_t suppressed_total
+) {
+    nlohmann::json root;
+    root["ts_ms"] = ts_ms;
+    root["frame_index"] = frame_index;
+    root["image_path"] = image_path;
+    root["unchanged"] = true;
+    root["ref_frame_index"] = ref_frame_index;
+    root["hamming"] = hamming_distance;
+    root["suppressed_total"] = suppressed_total;
+    return root.dump();
+}
+
 // temp implementation, not used yet
 bool parseSeatFrameStatesFromJson(const std::string& json, std::vector<SeatFrameState>& out) {
     return false;
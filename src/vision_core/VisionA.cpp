@@ -8,9 +8,13 @@
 #include "seatui/vision/Mog2.h"
 #include "seatui/vision/Snapshotter.h"
 #include "seatui/vision/Nms.h"
+#include "seatui/vision/Tracker.h"
+#include "seatui/vision/SeatClassifier.h"
+#include "seatui/vision/FrameDedup.h"
 #include <opencv2/imgproc.hpp>
 #include <fstream>
 #include <chrono>
+#include <cmath>
 
 
 namespace vision {
@@ -28,6 +32,23 @@ namespace vision {
         std::vector<BBox> last_persons;
         std::vector<BBox> last_objects;
         std::unique_ptr<Snapshotter> snapshotter; // 快照器
+        std::unique_ptr<MultiObjectTracker> tracker; // 多目标跟踪器 (cfg.tracker_enable 时构造)
+        int64_t frames_seen = 0;                     // 已处理帧计数, 用于 detect_every_k_frames 调度
+        std::unique_ptr<OrtSeatClassifier> seat_classifier; // 座位裁剪分类后端 (cfg.occupancy_backend == "seat_classifier")
+
+        // 脏座位检测缓存: 与 seats 一一对应, 记录上次评估时的 ROI 签名与输出
+        struct SeatCache {
+            bool valid = false;
+            float sig_mean = 0.f, sig_std = 0.f;   // 上次评估时的缩略灰度签名
+            int64_t evaluated_frame = -1;          // 上次评估时的 frames_seen
+            bool has_last = false;                 // last 有效 (不论 dirty_seat_enable, 分类无结论时沿用)
+            SeatFrameState last;
+        };
+        std::vector<SeatCache> seat_cache;
+        cv::Mat gray;                              // 当前帧灰度图 (dirty_seat_enable 时每帧计算一次)
+        std::unique_ptr<FrameDeduper> deduper;     // 近重复帧抑制 (cfg.frame_dedup_enable 时构造)
+        Publisher* publisher = nullptr;            // 不持有; 非空时每帧结果推送给下游 (进程内交接)
+        std::vector<SeatFrameState> last_out;      // 上一处理帧的座位状态, 近重复帧沿用 (publishUnchanged)
         struct SizeParseResult {
             cv::Mat img;
             float scale;
@@ -52,6 +73,142 @@ namespace vision {
 
             return {canvas, scaling_rate, dx, dy};
         }
+
+        // 座位外接矩形（多边形优先），裁剪到画面内
+        static cv::Rect seatBounds(const SeatROI& seat, const cv::Mat& frame) {
+            cv::Rect r = seat.poly.size() >= 3 ? cv::boundingRect(seat.poly) : seat.rect;
+            return r & cv::Rect(0, 0, frame.cols, frame.rows);
+        }
+
+        // 快照策略: 使用 occupancy_state + person/object count 生成状态哈希
+        void applySnapshot(SeatFrameState& sfs, const cv::Mat& bgr, int64_t ts_ms) {
+            if (!snapshotter) return;
+            int state_hash = static_cast<int>(sfs.occupancy_state) * 100 + sfs.person_count * 10 + sfs.object_count;
+            // 选择用于绘制的框集合（优先人，其次物）
+            std::vector<cv::Rect> snap_boxes;
+            if (!sfs.person_boxes_in_roi.empty()) {
+                for (auto &b : sfs.person_boxes_in_roi) snap_boxes.push_back(b.rect);
+            } else if (!sfs.object_boxes_in_roi.empty()) {
+                for (auto &b : sfs.object_boxes_in_roi) snap_boxes.push_back(b.rect);
+            } else {
+                snap_boxes.push_back(sfs.seat_roi); // 无检测时使用座位 ROI
+            }
+            sfs.snapshot_path = snapshotter->saveSnapshot(
+                std::to_string(sfs.seat_id),
+                state_hash,
+                ts_ms,
+                bgr,
+                snap_boxes);
+        }
+
+        // 计算座位 ROI 签名并判断是否可沿用上次状态; 需重新评估时返回 false
+        bool seatUnchanged(size_t i, int64_t frame_no, float& sig_mean, float& sig_std) {
+            if (!cfg.dirty_seat_enable || gray.empty()) return false;
+            cv::Rect r = seatBounds(seats[i], gray);
+            if (r.area() <= 0) return false;
+            const int thumb = std::max(4, cfg.dirty_seat_thumb);
+            cv::Mat small;
+            cv::resize(gray(r), small, cv::Size(thumb, thumb), 0, 0, cv::INTER_AREA);
+            cv::Scalar m, sd;
+            cv::meanStdDev(small, m, sd);
+            sig_mean = static_cast<float>(m[0]);
+            sig_std  = static_cast<float>(sd[0]);
+
+            const SeatCache& c = seat_cache[i];
+            if (!c.valid) return false;
+            if (cfg.dirty_seat_refresh_frames > 0 &&
+                frame_no - c.evaluated_frame >= cfg.dirty_seat_refresh_frames) return false;
+            // 与上次 "评估" 时比较而非上一帧, 避免缓慢漂移被逐帧吞掉
+            return std::fabs(sig_mean - c.sig_mean) <= cfg.dirty_seat_mean_delta &&
+                   std::fabs(sig_std  - c.sig_std)  <= cfg.dirty_seat_std_delta;
+        }
+
+        // 沿用座位上次状态: 仅刷新时间戳/帧号, 不重复触发快照
+        SeatFrameState carryForward(size_t i, int64_t ts_ms, int64_t frame_index) const {
+            SeatFrameState sfs = seat_cache[i].last;
+            sfs.ts_ms = ts_ms;
+            sfs.frame_index = frame_index;
+            sfs.snapshot_path.clear();
+            sfs.t_inf_ms = 0;
+            sfs.carried_forward = true;
+            return sfs;
+        }
+
+        void remember(size_t i, int64_t frame_no, float sig_mean, float sig_std, const SeatFrameState& sfs) {
+            if (!cfg.dirty_seat_enable && !seat_classifier) return;
+            SeatCache& c = seat_cache[i];
+            c.last = sfs;
+            c.has_last = true;
+            if (!cfg.dirty_seat_enable) return;
+            c.valid = true;
+            c.sig_mean = sig_mean;
+            c.sig_std = sig_std;
+            c.evaluated_frame = frame_no;
+        }
+
+        // 座位裁剪分类后端: 所有座位裁剪图一次批量分类，结果直接映射为 SeatOccupancyState
+        //   dirty_seat_enable 时只裁剪/分类 ROI 发生变化的座位
+        //   分类无结论 (UNKNOWN: 推理失败等) 的座位沿用上次状态; 从未评估过的座位本帧不输出, Judger 保持原状态
+        void processSeatCls(const cv::Mat& bgr, const cv::Mat& fg_mask,
+                            int64_t ts_ms, int64_t frame_index, int64_t frame_no,
+                            std::vector<SeatFrameState>& out) {
+            std::vector<cv::Mat> crops;
+            std::vector<size_t> dirty;                       // 需要分类的座位下标
+            std::vector<float> sig_m(seats.size(), 0.f), sig_s(seats.size(), 0.f);
+            std::vector<bool> unchanged(seats.size(), false);
+            crops.reserve(seats.size());
+            for (size_t i = 0; i < seats.size(); ++i) {
+                unchanged[i] = seatUnchanged(i, frame_no, sig_m[i], sig_s[i]);
+                if (unchanged[i]) continue;
+                cv::Rect r = seatBounds(seats[i], bgr);
+                crops.push_back(r.area() > 0 ? bgr(r) : cv::Mat());
+                dirty.push_back(i);
+            }
+
+            auto t_inf0 = std::chrono::high_resolution_clock::now();
+            std::vector<SeatClsResult> dirty_results = seat_classifier->classify(crops);
+            auto t_inf1 = std::chrono::high_resolution_clock::now();
+            int inf_ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(t_inf1 - t_inf0).count());
+
+            std::vector<SeatClsResult> results(seats.size());
+            for (size_t k = 0; k < dirty.size(); ++k) results[dirty[k]] = dirty_results[k];
+
+            for (size_t i = 0; i < seats.size(); ++i) {
+                if (unchanged[i]) {
+                    out.push_back(carryForward(i, ts_ms, frame_index));
+                    continue;
+                }
+                if (results[i].state == SeatOccupancyState::UNKNOWN) {
+                    // 不 remember: 签名停在上次评估, 下一帧重新分类
+                    if (seat_cache[i].has_last) out.push_back(carryForward(i, ts_ms, frame_index));
+                    continue;
+                }
+                const SeatROI& seat = seats[i];
+                SeatFrameState sfs;
+                sfs.seat_id = seat.seat_id;
+                sfs.ts_ms = ts_ms;
+                sfs.frame_index = frame_index;
+                sfs.seat_roi = seat.rect;
+                sfs.seat_poly = seat.poly;
+                sfs.fg_ratio = seat.poly.size() >= 3 ? Mog2Manager::ratioInPoly(fg_mask, seat.poly)
+                                                     : mog2.ratioInRoi(fg_mask, seat.rect);
+
+                const SeatClsResult& r = results[i];
+                sfs.occupancy_state = r.state;
+                sfs.has_person = (r.state == SeatOccupancyState::PERSON || r.state == SeatOccupancyState::PERSON_AND_OBJECT);
+                sfs.has_object = (r.state == SeatOccupancyState::OBJECT_ONLY || r.state == SeatOccupancyState::PERSON_AND_OBJECT);
+                // 分类器不输出框：计数按有无记 0/1，置信度记为类别概率
+                sfs.person_count = sfs.has_person ? 1 : 0;
+                sfs.object_count = sfs.has_object ? 1 : 0;
+                if (sfs.has_person) sfs.person_conf_max = r.conf;
+                if (sfs.has_object) sfs.object_conf_max = r.conf;
+                sfs.t_inf_ms = inf_ms;
+
+                applySnapshot(sfs, bgr, ts_ms);
+                remember(i, frame_no, sig_m[i], sig_s[i], sfs);
+                out.push_back(std::move(sfs));
+            }
+        }
     };
 
     VisionA::VisionA(const VisionConfig& cfg) 
@@ -59,6 +216,7 @@ namespace vision {
     {
         impl_->cfg = cfg;
         loadSeatsFromJson(cfg.seats_json, impl_->seats);
+        impl_->seat_cache.resize(impl_->seats.size());
         
         // 构造检测器
         impl_->detector.reset(new OrtYoloDetector(OrtYoloDetector::SessionOptions{
@@ -76,8 +234,40 @@ namespace vision {
         policy.jpg_quality     = cfg.snapshot_jpg_quality;
         impl_->snapshotter.reset(new Snapshotter(cfg.snapshot_dir, policy));
 
+        // 初始化跟踪器
+        if (cfg.tracker_enable) {
+            TrackerConfig tcfg;
+            tcfg.iou_match = cfg.tracker_iou_match;
+            tcfg.high_conf = cfg.tracker_high_conf;
+            tcfg.max_age   = cfg.tracker_max_age;
+            tcfg.min_hits  = cfg.tracker_min_hits;
+            impl_->tracker.reset(new MultiObjectTracker(tcfg));
+        }
+
+        if (cfg.frame_dedup_enable) {
+            impl_->deduper.reset(new FrameDeduper(cfg.frame_dedup_hamming, cfg.frame_dedup_max_skip));
+        }
+
+        // 座位裁剪分类后端（替代整帧 YOLO）
+        if (cfg.occupancy_backend == "seat_classifier") {
+            OrtSeatClassifier::SessionOptions copt;
+            copt.model_path    = cfg.seat_cls_model_path;
+            copt.input_w       = cfg.seat_cls_input_w;
+            copt.input_h       = cfg.seat_cls_input_h;
+            copt.intra_threads = cfg.intra_threads;
+            copt.output_probs  = cfg.seat_cls_output == "probs";
+            if (cfg.seat_cls_output != "probs" && cfg.seat_cls_output != "logits") {
+                std::cerr << "[VisionA] Unknown seat_cls_output \"" << cfg.seat_cls_output << "\", using logits.\n";
+            }
+            impl_->seat_classifier.reset(new OrtSeatClassifier(copt));
+            if (!impl_->seat_classifier->isReady()) {
+                std::cerr << "[VisionA] Seat classifier not ready, falling back to YOLO backend.\n";
+                impl_->seat_classifier.reset();
+            }
+        }
+
         // 输出VisionA配置内的座位表绝对路径与座位计数，检测座位计数是否准确（按照demo应当为4）
-        std::cout << "[VisionA] Seats file abs: " << std::filesystem::absolute(cfg.seats_json) << ", seatCount=" << vision.seatCount() << std::endl;
+        std::cout << "[VisionA] Seats file abs: " << std::filesystem::absolute(cfg.seats_json) << ", seatCount=" << seatCount() << std::endl;
     }
 
     VisionA::~VisionA() = default;
@@ -86,6 +276,18 @@ namespace vision {
         return static_cast<int>(impl_->seats.size());
     }
 
+    std::string VisionA::occupancyBackend() const {
+        return impl_->seat_classifier ? "seat_classifier" : "yolo";
+    }
+
+    bool VisionA::isNearDuplicate(const cv::Mat& bgr, int64_t frame_index) {
+        return impl_->deduper && impl_->deduper->isNearDuplicate(bgr, frame_index);
+    }
+
+    FrameDedupStats VisionA::dedupStats() const {
+        return impl_->deduper ? impl_->deduper->stats() : FrameDedupStats{};
+    }
+
     std::vector<SeatFrameState> VisionA::processFrame(const cv::Mat& bgr, 
                                                       int64_t ts_ms, 
                                                       int64_t frame_index) 
@@ -104,56 +306,87 @@ namespace vision {
 
         std::cout << "[VisionA] Foreground mask computed.\n";
 
-        // 2. 预处理：letterbox（保持比例，减少形变）
-        auto sizeParseRes = Impl::sizeParse(bgr, 640);
-        auto parsed_img = sizeParseRes.img;
+        const int64_t frame_no = impl_->frames_seen++;
+        if (impl_->cfg.dirty_seat_enable) {
+            cv::cvtColor(bgr, impl_->gray, cv::COLOR_BGR2GRAY);
+        }
 
-        std::cout << "[VisionA] Image resized for inference.\n";
+        // 座位裁剪分类后端：不跑整帧检测，直接逐座位出状态
+        if (impl_->seat_classifier) {
+            impl_->last_persons.clear();
+            impl_->last_objects.clear();
+            impl_->processSeatCls(bgr, fg_mask, ts_ms, frame_index, frame_no, out);
+            auto t1 = std::chrono::high_resolution_clock::now();
+            int total_ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count());
+            for (auto& each_sfs : out) each_sfs.t_post_ms = total_ms;
+            impl_->last_out = out;
+            if (impl_->publisher) impl_->publisher->publish(out);
+            return out;
+        }
 
-        // 3. 推理: chg RawDet -> BBox
-        std::vector<RawDet> raw_detected;
-        try {
-            raw_detected = impl_->detector->infer(parsed_img);
+        // 跟踪模式下每 K 帧才运行一次检测器，其余帧由跟踪器预测框位置
+        const int k_frames = std::max(1, impl_->cfg.detect_every_k_frames);
+        const bool run_detector = !impl_->tracker || (frame_no % k_frames == 0);
 
-            std::cout << "[VisionA] Inference successful. Raw detections obtained: " << raw_detected.size() << "\n";
+        std::vector<BBox> dets;
+        if (run_detector) {
+            // 2. 预处理：letterbox（保持比例，减少形变）
+            auto sizeParseRes = Impl::sizeParse(bgr, 640);
+            auto parsed_img = sizeParseRes.img;
+
+            std::cout << "[VisionA] Image resized for inference.\n";
+
+            // 3. 推理: chg RawDet -> BBox
+            std::vector<RawDet> raw_detected;
+            try {
+                raw_detected = impl_->detector->infer(parsed_img);
+
+                std::cout << "[VisionA] Inference successful. Raw detections obtained: " << raw_detected.size() << "\n";
+
+            } catch (const std::exception& ex) {
+                // 捕获 ONNX/推理异常，打印一次并继续返回空检测，避免整个程序退出
+                static bool warned = false;
+                if (!warned) {
+                    std::cerr << "[VisionA] infer exception: " << ex.what() << "\n";
+                    warned = true;
+                }
+                raw_detected.clear();
+            }
 
-        } catch (const std::exception& ex) {
-            // 捕获 ONNX/推理异常，打印一次并继续返回空检测，避免整个程序退出
-            static bool warned = false;
-            if (!warned) {
-                std::cerr << "[VisionA] infer exception: " << ex.what() << "\n";
-                warned = true;
+            // chg RawDet -> BBox
+            dets.reserve(raw_detected.size());
+            for (auto& r : raw_detected) {
+                BBox b;
+                // scale to original
+                float sx = static_cast<float>(bgr.cols) / 640.f;
+                float sy = static_cast<float>(bgr.rows) / 640.f;
+                float x = r.cx - r.w * 0.5f;
+                float y = r.cy - r.h * 0.5f;
+                b.rect = cv::Rect(static_cast<int>(x * sx), 
+                                  static_cast<int>(y * sy), 
+                                  static_cast<int>(r.w * sx), 
+                                  static_cast<int>(r.h * sy));
+                b.conf = r.conf;
+                b.cls_id = r.cls_id;
+                b.cls_name = (r.cls_id == 0 ? "person" : "object");
+                dets.push_back(b);
             }
-            raw_detected.clear();
-        }
 
-        // chg RawDet -> BBox
-        std::vector<BBox> dets;
-        dets.reserve(raw_detected.size());
-        for (auto& r : raw_detected) {
-            BBox b;
-            // scale to original
-            float sx = static_cast<float>(bgr.cols) / 640.f;
-            float sy = static_cast<float>(bgr.rows) / 640.f;
-            float x = r.cx - r.w * 0.5f;
-            float y = r.cy - r.h * 0.5f;
-            b.rect = cv::Rect(static_cast<int>(x * sx), 
-                              static_cast<int>(y * sy), 
-                              static_cast<int>(r.w * sx), 
-                              static_cast<int>(r.h * sy));
-            b.conf = r.conf;
-            b.cls_id = r.cls_id;
-            b.cls_name = (r.cls_id == 0 ? "person" : "object");
-            dets.push_back(b);
-        }
+            // 4. NMS：按类别做 NMS，减少重叠框
+            const float nms_iou = std::max(0.f, std::min(1.f, impl_->cfg.nms_iou));
+            if (!dets.empty() && nms_iou > 0.f) {
+                dets = nmsClasswise(dets, nms_iou);
+            }
 
-        // 4. NMS：按类别做 NMS，减少重叠框
-        const float nms_iou = std::max(0.f, std::min(1.f, impl_->cfg.nms_iou));
-        if (!dets.empty() && nms_iou > 0.f) {
-            dets = nmsClasswise(dets, nms_iou);
-        }
+            std::cout << "[VisionA] Inference completed. Detected " << dets.size() << " objects (after NMS).\n";
 
-        std::cout << "[VisionA] Inference completed. Detected " << dets.size() << " objects (after NMS).\n";
+            // 检测帧：关联检测框并分配稳定 track_id
+            if (impl_->tracker) dets = impl_->tracker->update(dets);
+        } else {
+            // 跳过推理：使用已确认轨迹的预测框
+            dets = impl_->tracker->predict();
+            std::cout << "[VisionA] Detector skipped, tracker predicted " << dets.size() << " boxes.\n";
+        }
 
         // 5. 人与物简易分类
         std::vector<BBox> persons, objects;   // persons boxes and objects boxes
@@ -194,7 +427,18 @@ namespace vision {
     *  record all the result into the vector containing all the SeatFrameState 
     *  (denoted as out, std::vector<SeatFrameState> )
     */
-        for (auto& each_seat : impl_->seats) {  // for each seat in seats table
+        size_t carried = 0;
+        for (size_t seat_idx = 0; seat_idx < impl_->seats.size(); ++seat_idx) {  // for each seat in seats table
+            const SeatROI& each_seat = impl_->seats[seat_idx];
+
+            // 脏座位检测: ROI 未变化则沿用上次状态, 跳过归属/前景/快照计算
+            float sig_mean = 0.f, sig_std = 0.f;
+            if (impl_->seatUnchanged(seat_idx, frame_no, sig_mean, sig_std)) {
+                out.push_back(impl_->carryForward(seat_idx, ts_ms, frame_index));
+                ++carried;
+                continue;
+            }
+
             SeatFrameState sfs;
             sfs.seat_id = each_seat.seat_id;
             sfs.ts_ms = ts_ms;
@@ -279,32 +523,33 @@ namespace vision {
                 }
             }
 
-            // 快照策略: 使用 occupancy_state + person/object count 生成状态哈希
-            if (impl_->snapshotter) {
-                int state_hash = static_cast<int>(sfs.occupancy_state) * 100 + sfs.person_count * 10 + sfs.object_count;
-                // 选择用于绘制的框集合（优先人，其次物）
-                std::vector<cv::Rect> snap_boxes;
-                if (!sfs.person_boxes_in_roi.empty()) {
-                    for (auto &b : sfs.person_boxes_in_roi) snap_boxes.push_back(b.rect);
-                } else if (!sfs.object_boxes_in_roi.empty()) {
-                    for (auto &b : sfs.object_boxes_in_roi) snap_boxes.push_back(b.rect);
-                } else {
-                    snap_boxes.push_back(sfs.seat_roi); // 无检测时使用座位 ROI
-                }
-                std::string snap_path = impl_->snapshotter->saveSnapshot(
-                    std::to_string(sfs.seat_id),
-                    state_hash,
-                    ts_ms,
-                    bgr,
-                    snap_boxes);
-                sfs.snapshot_path = snap_path;
-            }
+            // 快照策略
+            impl_->applySnapshot(sfs, bgr, ts_ms);
+            impl_->remember(seat_idx, frame_no, sig_mean, sig_std, sfs);
             out.push_back(std::move(sfs));
         }
+        if (impl_->cfg.dirty_seat_enable) {
+            std::cout << "[VisionA] Dirty seats re-evaluated: " << (out.size() - carried)
+                      << ", carried forward: " << carried << "\n";
+        }
         
         auto t1 = std::chrono::high_resolution_clock::now();
         int total_ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count());
         for (auto& each_sfs : out) each_sfs.t_post_ms = total_ms; // 简化: 全流程耗时
+        impl_->last_out = out;
+        if (impl_->publisher) impl_->publisher->publish(out);
+        return out;
+    }
+
+    std::vector<SeatFrameState> VisionA::publishUnchanged(int64_t ts_ms, int64_t frame_index) {
+        std::vector<SeatFrameState> out = impl_->last_out;
+        for (auto& sfs : out) {
+            sfs.ts_ms = ts_ms;
+            sfs.frame_index = frame_index;
+            sfs.snapshot_path.clear();   // 本帧未截图
+            sfs.t_post_ms = 0;
+        }
+        if (impl_->publisher && !out.empty()) impl_->publisher->publish(out);
         return out;
     }
 
@@ -314,8 +559,7 @@ namespace vision {
     }
 
     void VisionA::setPublisher(Publisher* p) {
-        // 留空：demo 未使用
-        (void)p;
+        impl_->publisher = p;
     }
 
 } // namespace vision
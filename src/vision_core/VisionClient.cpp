@@ -87,9 +87,13 @@ namespace vision {
     
         // Publish part
         Publisher pub;
-        pub.setCallback([](const std::vector<SeatFrameState>& states){
-            std::cout << "[VisionClient] Callback batch size = " << states.size() << "\n";
-        });
+        if (publish_cb_) {
+            pub.setCallback(publish_cb_);
+        } else {
+            pub.setCallback([](const std::vector<SeatFrameState>& states){
+                std::cout << "[VisionClient] Callback batch size = " << states.size() << "\n";
+            });
+        }
         vision.setPublisher(&pub);
 
         // create output path (skip if no parent path included)
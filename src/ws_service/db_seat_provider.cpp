@@ -0,0 +1,72 @@
+#include <seatui/db_seat_provider.hpp>
+#include "../db_core/SeatDatabase.h"
+
+#include <QtCore/QDateTime>
+#include <algorithm>
+#include <cctype>
+
+namespace seatui {
+
+namespace {
+
+ZoneInfo toZoneInfo(const ZoneStatus& z) {
+    ZoneInfo info;
+    info.zone_id = z.zone_id;
+    info.name = QString::fromStdString(z.name);
+    info.area = QRectF(z.roi_x, z.roi_y, z.roi_width, z.roi_height);
+    info.seat_total = z.seat_total;
+    info.seat_occupied = z.seat_occupied;
+    info.occupancy_ratio = z.occupancyRatio();
+    return info;
+}
+
+SeatState toSeatState(const std::string& state) {
+    if (state == "Seated") return SeatState::Seated;
+    if (state == "Anomaly") return SeatState::Anomaly;
+    return SeatState::Unseated;
+}
+
+// DB 的 seat_id 是字符串（"1"、"S1"），SeatInfo::seat_id 是 int：取其中的数字
+int seatNumber(const std::string& id) {
+    std::string digits;
+    for (char c : id) if (std::isdigit(static_cast<unsigned char>(c))) digits.push_back(c);
+    if (digits.empty() || digits.size() > 9) return -1;
+    return std::stoi(digits);
+}
+
+} // namespace
+
+DbSeatProvider::DbSeatProvider(SeatDatabase& db, QObject* parent)
+    : ISeatProvider(parent), db_(db) {
+    qRegisterMetaType<seatui::ZoneInfo>("seatui::ZoneInfo");
+    // 在写库线程（judger）上回调；跨线程的接收者由 Qt 排队
+    db_.setZoneListener([this](const ZoneStatus& zone) { emit zoneUpdated(toZoneInfo(zone)); });
+}
+
+DbSeatProvider::~DbSeatProvider() {
+    db_.setZoneListener(nullptr);   // 之后不会再有回调
+}
+
+std::vector<SeatInfo> DbSeatProvider::seats() const {
+    std::vector<SeatInfo> out;
+    const qint64 now_ms = QDateTime::currentMSecsSinceEpoch();
+    for (const auto& s : db_.getCurrentSeatStatus()) {
+        SeatInfo info;
+        info.seat_id = seatNumber(s.seat_id);
+        info.state = toSeatState(s.state);
+        info.last_update = QDateTime::fromMSecsSinceEpoch(s.last_update_ms, Qt::UTC);
+        info.zone_name = QString::fromStdString(s.zone);
+        info.roi = QRectF(s.roi_x, s.roi_y, s.roi_width, s.roi_height);
+        info.occupied_seconds = static_cast<int>(std::max<qint64>(0, now_ms - s.last_update_ms) / 1000);
+        out.push_back(info);
+    }
+    return out;
+}
+
+std::vector<ZoneInfo> DbSeatProvider::zones() const {
+    std::vector<ZoneInfo> out;
+    for (const auto& z : db_.getZoneStatus()) out.push_back(toZoneInfo(z));
+    return out;
+}
+
+} // namespace seatui
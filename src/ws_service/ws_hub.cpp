@@ -252,15 +252,8 @@ void WsHub::onTickPush() {
         // 状态原样转文字（DB是 "Seated"/"Unseated"/"Anomaly"）
         seatObj["state"] = QString::fromStdString(seatStatus.state);
 
-        // 关键：把 DB 的 "yyyy-MM-dd HH:mm:ss"(本地时) 统一转为 UTC ISO 再发
-        QString last = QString::fromStdString(seatStatus.last_update);  // e.g. "2025-12-03 16:42:37"
-        QString lastIso = last;
-        QDateTime dt = QDateTime::fromString(last, "yyyy-MM-dd HH:mm:ss");
-        if (dt.isValid()) {
-            // 注意这里转 UTC，生成 "...Z"
-            lastIso = dt.toUTC().toString(Qt::ISODate);
-        }
-        seatObj["last_update"] = lastIso;
+        // DB 存 epoch ms，只在这里格式化为 UTC ISO ("...Z")
+        seatObj["last_update"] = QDateTime::fromMSecsSinceEpoch(seatStatus.last_update_ms, Qt::UTC).toString(Qt::ISODate);
 
         seatsArray.append(seatObj);
     }
@@ -279,6 +272,14 @@ void WsHub::onTickPush() {
 
 
 
+void WsHub::publishZone(const seatui::ZoneInfo& zone) {
+    QJsonObject root;
+    root["type"] = "zone_update";
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["zone"] = seatui::toJson(zone);
+    broadcast(QJsonDocument(root).toJson());
+}
+
 void WsHub::broadcast(const QString& message, const QString& onlyRole) {
     for (auto* client : clients_) {
         if (!onlyRole.isEmpty()) {
@@ -301,7 +302,7 @@ QString WsHub::makeSeatSnapshotJson() {
         QJsonObject seatObj;
         seatObj["seat_id"] = QString::fromStdString(seatStatus.seat_id);
         seatObj["state"] = QString::fromStdString(seatStatus.state);
-        seatObj["since"] = QString::fromStdString(seatStatus.last_update);
+        seatObj["since"] = QDateTime::fromMSecsSinceEpoch(seatStatus.last_update_ms, Qt::UTC).toString(Qt::ISODate);
         items.append(seatObj);
     }
 
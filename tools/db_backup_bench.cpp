@@ -0,0 +1,112 @@
+// db_backup_bench: online backup (SeatDbBackup) of a database that is being written to
+//
+// 用法: ./db_backup_bench [db=db_backup_bench.db] [--rows=2000000] [--pages=256] [--sleep-ms=10] [--keep=3]
+//   - 先写 rows 行 seat_snapshots 作为底数据, 然后一边备份一边由 SeatDbWriter 持续写入 (每 2 ms 一行)
+//   - 报告: 备份耗时 / 字节数 / bytes/s / 单步最长持有写连接时间, 以及备份期间写入的延迟 (insert + flush)
+//   - 备份文件用 integrity_check 校验; 行数 >= 备份开始前的行数
+#include "../src/db_core/SeatDatabase.h"
+#include "../src/db_core/SeatDbBackup.h"
+#include "../src/db_core/SeatDbWriter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char* argv[]) {
+    std::string db_path = "db_backup_bench.db";
+    int64_t rows = 2000000;
+    SeatDbBackupConfig cfg;
+    cfg.keep = 3;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a.rfind("--rows=", 0) == 0) rows = std::atoll(a.c_str() + 7);
+        else if (a.rfind("--pages=", 0) == 0) cfg.pages_per_step = std::atoi(a.c_str() + 8);
+        else if (a.rfind("--sleep-ms=", 0) == 0) cfg.step_sleep_ms = std::atoi(a.c_str() + 11);
+        else if (a.rfind("--keep=", 0) == 0) cfg.keep = std::atoi(a.c_str() + 7);
+        else db_path = a;
+    }
+    if (db_path == ":memory:") {
+        std::cout << "db_backup_bench needs a database file" << std::endl;
+        return 1;
+    }
+    for (const char* suffix : {"", "-wal", "-shm"}) std::remove((db_path + suffix).c_str());
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+    SeatDatabase& db = SeatDatabase::getInstance(db_path);
+    if (!db.initialize()) {
+        std::cout.rdbuf(console);
+        return 1;
+    }
+    const int64_t ts0 = 1700000000000LL;
+    {
+        SQLite::Database loader(db_path, SQLite::OPEN_READWRITE);
+        SQLite::Statement ins(loader, "INSERT INTO seat_snapshots (ts_ms, seat_id, state, person_count) VALUES (?, ?, ?, 1)");
+        for (int64_t i = 0; i < rows;) {
+            loader.exec("BEGIN");
+            for (int64_t end = std::min(rows, i + 100000); i < end; ++i) {
+                ins.bind(1, ts0 + i * 10);
+                ins.bind(2, "S" + std::to_string(i % 100 + 1));
+                ins.bind(3, i % 3 ? "Seated" : "Unseated");
+                ins.exec();
+                ins.reset();
+            }
+            loader.exec("COMMIT");
+        }
+        loader.exec("PRAGMA wal_checkpoint(TRUNCATE)");
+    }
+    const int64_t rows_before = db.countRows("seat_snapshots");
+
+    // concurrent writer: one row every 2 ms, latency of insert + flush (what the judger would wait for)
+    std::atomic<bool> done{false};
+    std::vector<double> latencies;
+    std::thread producer([&] {
+        SeatDbWriter writer(db);
+        int64_t i = 0;
+        while (!done) {
+            const auto w0 = Clock::now();
+            writer.insertSnapshot(ts0 + (rows + i) * 10, "S1", "Seated", 1);
+            writer.flush();
+            latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - w0).count());
+            ++i;
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    });
+
+    SeatDbBackup backup(db, cfg);
+    const SeatDbBackupResult r = backup.run();
+    done = true;
+    producer.join();
+    std::cout.rdbuf(console);
+
+    int64_t rows_copy = -1;
+    if (r.ok) {
+        SQLite::Database copy(r.path, SQLite::OPEN_READONLY);
+        rows_copy = copy.execAndGet("SELECT COUNT(*) FROM seat_snapshots").getInt64();
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto pct = [&](double p) { return latencies.empty() ? 0.0 : latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "db: " << db_path << ", " << rows_before << " snapshot rows\n"
+              << "backup: " << (r.ok ? r.path : "FAILED: " + r.error) << "\n"
+              << "  " << r.bytes << " bytes, " << r.pages << " pages, " << r.steps << " steps (" << r.retries
+              << " busy), " << r.seconds << " s, " << r.bytes_per_sec / (1024 * 1024) << " MiB/s\n"
+              << "  longest step holding the writer: " << r.max_step_ms << " ms (" << cfg.pages_per_step
+              << " pages/step, " << cfg.step_sleep_ms << " ms sleep)\n"
+              << "  integrity_check: " << r.integrity << ", rows in copy: " << rows_copy
+              << " (>= " << rows_before << ")\n"
+              << "writes during backup: " << latencies.size() << ", insert+flush p50 " << pct(0.5) << " ms, p99 "
+              << pct(0.99) << " ms, max " << pct(1.0) << " ms" << std::endl;
+    return r.ok && rows_copy >= rows_before ? 0 : 1;
+}
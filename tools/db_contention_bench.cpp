@@ -0,0 +1,130 @@
+// db_contention_bench: UI-style readers polling getCurrentSeatStatus while the judger writes at full rate
+//
+// 用法: ./db_contention_bench [db=db_contention_bench.db] [--readers=4] [--seconds=5] [--seats=100]
+//   - 写线程: SeatDbWriter (与 judger 队列模式相同的写路径), 不限速写 seat_events / seat_snapshots
+//   - 读线程: 循环调用 getCurrentSeatStatus(), 统计每次调用延迟 (p50 / p99 / max) 与总查询次数
+//   - 先单独跑读线程 (无写入) 作为基线, 再与写线程并发, 对比读延迟和写入 rows/s
+#include "../src/db_core/SeatDatabase.h"
+#include "../src/db_core/SeatDbWriter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct ReadResult {
+    std::vector<double> latency_ms;
+};
+
+static void report(const char* name, std::vector<ReadResult>& per_reader, double sec) {
+    std::vector<double> all;
+    for (auto& r : per_reader) all.insert(all.end(), r.latency_ms.begin(), r.latency_ms.end());
+    std::sort(all.begin(), all.end());
+    auto pct = [&](double p) { return all.empty() ? 0.0 : all[std::min(all.size() - 1, static_cast<size_t>(p * all.size()))]; };
+    std::cout << "  " << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(2)
+              << " queries=" << std::setw(7) << all.size()
+              << " qps=" << std::setw(9) << (sec > 0 ? all.size() / sec : 0.0)
+              << " p50=" << std::setw(7) << pct(0.50) << " ms"
+              << " p99=" << std::setw(7) << pct(0.99) << " ms"
+              << " max=" << std::setw(7) << (all.empty() ? 0.0 : all.back()) << " ms\n";
+}
+
+static double runReaders(SeatDatabase& db, int readers, double seconds, std::vector<ReadResult>& out) {
+    out.assign(readers, ReadResult());
+    std::vector<std::thread> threads;
+    const auto t0 = Clock::now();
+    const auto end = t0 + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            while (Clock::now() < end) {
+                auto q0 = Clock::now();
+                auto seats = db.getCurrentSeatStatus();
+                (void)seats;
+                out[r].latency_ms.push_back(std::chrono::duration<double, std::milli>(Clock::now() - q0).count());
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::string db_path = "db_contention_bench.db";
+    int readers = 4;
+    double seconds = 5.0;
+    int seats = 100;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a.rfind("--readers=", 0) == 0) readers = std::atoi(a.c_str() + 10);
+        else if (a.rfind("--seconds=", 0) == 0) seconds = std::atof(a.c_str() + 10);
+        else if (a.rfind("--seats=", 0) == 0) seats = std::atoi(a.c_str() + 8);
+        else db_path = a;
+    }
+    if (db_path != ":memory:") {
+        for (const char* suffix : {"", "-wal", "-shm"}) std::remove((db_path + suffix).c_str());
+    }
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+    SeatDatabase& db = SeatDatabase::getInstance(db_path);
+    if (!db.initialize()) {
+        std::cout.rdbuf(console);
+        return 1;
+    }
+
+    // seats plus a first event each, so every poll returns the full seat list
+    int64_t ts = 1700000000000LL;
+    {
+        SeatDbWriter writer(db);
+        for (int s = 1; s <= seats; ++s) {
+            db.insertSeat("S" + std::to_string(s), 10 * s, 10, 80, 80);
+            writer.insertSeatEvent("S" + std::to_string(s), "Unseated", ts, 0);
+        }
+        writer.flush();
+    }
+
+    std::vector<ReadResult> idle, busy;
+    double idle_sec = runReaders(db, readers, seconds, idle);
+
+    // concurrent: one writer thread at full rate
+    std::atomic<bool> stop{false};
+    uint64_t written = 0;
+    std::thread writer_thread([&] {
+        SeatDbWriter writer(db);
+        int64_t t = ts;
+        while (!stop.load(std::memory_order_relaxed)) {
+            t += 1000;
+            for (int s = 1; s <= seats; ++s) {
+                const std::string id = "S" + std::to_string(s);
+                writer.insertSeatEvent(id, (t / 1000 + s) % 7 == 0 ? "Seated" : "Unseated", t, 1);
+                writer.insertSnapshot(t, id, "Unseated", 0);
+            }
+            written += 2 * seats;
+        }
+        writer.flush();
+    });
+    const auto w0 = Clock::now();
+    double busy_sec = runReaders(db, readers, seconds, busy);
+    stop = true;
+    writer_thread.join();
+    double write_sec = std::chrono::duration<double>(Clock::now() - w0).count();
+    std::cout.rdbuf(console);
+
+    std::cout << "db: " << db_path << ", " << readers << " reader(s), " << seats << " seats, "
+              << seconds << " s per phase\n";
+    report("readers only", idle, idle_sec);
+    report("with writer", busy, busy_sec);
+    std::cout << std::fixed << std::setprecision(1)
+              << "  writer: " << written << " rows, " << (write_sec > 0 ? written / write_sec : 0.0) << " rows/s\n"
+              << "  seat_events rows: " << db.countRows("seat_events") << std::endl;
+    return 0;
+}
@@ -0,0 +1,127 @@
+// db_current_bench: getCurrentSeatStatus / getCurrentBasicStats latency vs. size of the event history
+//
+// 用法: ./db_current_bench [db=db_current_bench.db] [--events=10000000] [--seats=100] [--legacy-max=N]
+//   - 历史事件分批写入 seat_events (每 100k 行一个事务, 经过 seat_current 触发器)
+//   - 在 10k / 100k / 1M / 10M ... 事件处, 各查询重复执行取平均延迟:
+//       current : getCurrentSeatStatus()   (seat_current, O(座位数))
+//       stats   : getCurrentBasicStats()
+//       legacy  : 原来的相关子查询 (MAX(ts_ms) over seat_events), 给出 legacy-max 时只在事件数 <= N 时跑
+#include "../src/db_core/SeatDatabase.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static const char* kLegacyCurrentSql = R"(
+    SELECT s.seat_id, e.state, MAX(e.ts_ms) as last_update_ms
+    FROM seats s
+    LEFT JOIN seat_events e ON s.seat_id = e.seat_id
+    WHERE e.ts_ms = (SELECT MAX(ts_ms) FROM seat_events WHERE seat_id = s.seat_id)
+    GROUP BY s.seat_id
+)";
+
+template <typename F>
+static double avgMs(F&& f, int min_runs, double min_ms) {
+    int runs = 0;
+    const auto t0 = Clock::now();
+    double elapsed = 0.0;
+    while (runs < min_runs || elapsed < min_ms) {
+        f();
+        ++runs;
+        elapsed = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+    return elapsed / runs;
+}
+
+int main(int argc, char* argv[]) {
+    std::string db_path = "db_current_bench.db";
+    int64_t events = 10000000;
+    int seats = 100;
+    int64_t legacy_max = -1;   // -1 = always
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a.rfind("--events=", 0) == 0) events = std::atoll(a.c_str() + 9);
+        else if (a.rfind("--seats=", 0) == 0) seats = std::atoi(a.c_str() + 8);
+        else if (a.rfind("--legacy-max=", 0) == 0) legacy_max = std::atoll(a.c_str() + 13);
+        else db_path = a;
+    }
+    if (db_path == ":memory:") {
+        std::cout << "db_current_bench needs a database file (the loader uses its own connection)" << std::endl;
+        return 1;
+    }
+    for (const char* suffix : {"", "-wal", "-shm"}) std::remove((db_path + suffix).c_str());
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+    SeatDatabase& db = SeatDatabase::getInstance(db_path);
+    if (!db.initialize()) {
+        std::cout.rdbuf(console);
+        return 1;
+    }
+    for (int s = 1; s <= seats; ++s) db.insertSeat("S" + std::to_string(s), 10 * s, 10, 80, 80);
+    std::cout.rdbuf(console);
+
+    // bulk loader: own connection, large transactions (the trigger keeps seat_current up to date)
+    SQLite::Database loader(db_path, SQLite::OPEN_READWRITE);
+    loader.exec("PRAGMA synchronous = NORMAL");
+    SQLite::Statement insert(loader, "INSERT INTO seat_events (seat_id, state, ts_ms, duration_sec) VALUES (?, ?, ?, ?)");
+    std::vector<std::string> ids;
+    for (int s = 1; s <= seats; ++s) ids.push_back("S" + std::to_string(s));
+    const char* states[] = {"Seated", "Unseated", "Anomaly"};
+
+    std::vector<int64_t> marks;
+    for (int64_t m = 10000; m < events; m *= 10) marks.push_back(m);
+    marks.push_back(events);
+
+    std::cout << "db: " << db_path << ", " << seats << " seats (avg ms per call)\n"
+              << std::setw(12) << "events" << std::setw(12) << "current" << std::setw(12) << "stats"
+              << std::setw(12) << "legacy" << std::setw(12) << "load s" << "\n";
+
+    int64_t loaded = 0;
+    const int64_t ts0 = 1700000000000LL;
+    for (int64_t mark : marks) {
+        const auto l0 = Clock::now();
+        while (loaded < mark) {
+            const int64_t batch_end = std::min(mark, loaded + 100000);
+            loader.exec("BEGIN");
+            for (; loaded < batch_end; ++loaded) {
+                insert.bind(1, ids[loaded % seats]);
+                insert.bind(2, states[(loaded / seats) % 3]);
+                insert.bind(3, ts0 + (loaded / seats) * 1000);
+                insert.bind(4, static_cast<int>(loaded % 600));
+                insert.exec();
+                insert.reset();
+            }
+            loader.exec("COMMIT");
+        }
+        const double load_sec = std::chrono::duration<double>(Clock::now() - l0).count();
+
+        const double current_ms = avgMs([&] { db.getCurrentSeatStatus(); }, 5, 200.0);
+        const double stats_ms = avgMs([&] { db.getCurrentBasicStats(); }, 5, 200.0);
+        std::string legacy = "-";
+        if (legacy_max < 0 || loaded <= legacy_max) {
+            const double legacy_ms = avgMs([&] {
+                SQLite::Statement q(loader, kLegacyCurrentSql);
+                while (q.executeStep()) {}
+            }, 5, 200.0);
+            std::ostringstream os;
+            os << std::fixed << std::setprecision(3) << legacy_ms;
+            legacy = os.str();
+        }
+        std::cout << std::fixed << std::setprecision(3)
+                  << std::setw(12) << loaded << std::setw(12) << current_ms << std::setw(12) << stats_ms
+                  << std::setw(12) << legacy << std::setw(12) << std::setprecision(1) << load_sec << std::endl;
+    }
+
+    auto current = db.getCurrentSeatStatus();
+    std::cout << "  seats in current state: " << current.size() << std::endl;
+    return 0;
+}
@@ -0,0 +1,151 @@
+// db_interval_bench: seat_intervals range queries over months of events
+//
+// 用法: ./db_interval_bench [db=db_interval_bench.db] [--days=90] [--seats=100] [--change-sec=600]
+//   - 每个座位平均每 change-sec 秒换一次状态 (间隔随机), 经 seat_events 触发器生成 seat_intervals
+//   - legacy  : 原来的 getOccupiedMinutes, SUM(duration_sec) over seat_events (范围边缘按整条事件算)
+//   - minutes : getOccupiedMinutes(S1, ...)   (seat_intervals, 边缘精确裁剪)
+//   - seconds : getOccupiedSeconds(...)       (全部座位, 每个座位两次索引查找, 与范围长短无关)
+//   - at      : getSeatStatusAt(T)            (全部座位在 T 时刻的状态)
+#include "../src/db_core/SeatDatabase.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+static double avgMs(F&& f) {
+    int runs = 0;
+    const auto t0 = Clock::now();
+    double elapsed = 0.0;
+    while (runs < 3 || elapsed < 300.0) {
+        f();
+        ++runs;
+        elapsed = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+    return elapsed / runs;
+}
+
+int main(int argc, char* argv[]) {
+    std::string db_path = "db_interval_bench.db";
+    int days = 90;
+    int seats = 100;
+    int change_sec = 600;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a.rfind("--days=", 0) == 0) days = std::atoi(a.c_str() + 7);
+        else if (a.rfind("--seats=", 0) == 0) seats = std::atoi(a.c_str() + 8);
+        else if (a.rfind("--change-sec=", 0) == 0) change_sec = std::atoi(a.c_str() + 13);
+        else db_path = a;
+    }
+    if (db_path == ":memory:") {
+        std::cout << "db_interval_bench needs a database file (the loader uses its own connection)" << std::endl;
+        return 1;
+    }
+    for (const char* suffix : {"", "-wal", "-shm"}) std::remove((db_path + suffix).c_str());
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+    SeatDatabase& db = SeatDatabase::getInstance(db_path);
+    if (!db.initialize()) {
+        std::cout.rdbuf(console);
+        return 1;
+    }
+    for (int s = 1; s <= seats; ++s) db.insertSeat("S" + std::to_string(s), 10 * s, 10, 80, 80);
+    std::cout.rdbuf(console);
+
+    // bulk load through a second connection, one day per transaction, events in ts order
+    SQLite::Database conn(db_path, SQLite::OPEN_READWRITE);
+    conn.exec("PRAGMA synchronous = NORMAL");
+    const int64_t ts0 = 1700000000000LL;
+    const int64_t day_ms = 24 * 3600 * 1000LL;
+    const char* states[] = {"Seated", "Unseated", "Anomaly"};
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> gap(1000, 2LL * change_sec * 1000);
+    std::vector<int64_t> next(seats);
+    for (int s = 0; s < seats; ++s) next[s] = ts0 + gap(rng) / 2;
+    int64_t events = 0;
+    const auto l0 = Clock::now();
+    {
+        SQLite::Statement ins(conn, "INSERT INTO seat_events (seat_id, state, ts_ms, duration_sec) VALUES (?, ?, ?, ?)");
+        for (int d = 0; d < days; ++d) {
+            const int64_t day_end = ts0 + (d + 1) * day_ms;
+            conn.exec("BEGIN");
+            for (;;) {
+                const int s = static_cast<int>(std::min_element(next.begin(), next.end()) - next.begin());
+                if (next[s] >= day_end) break;
+                const int64_t g = gap(rng);
+                ins.bind(1, "S" + std::to_string(s + 1));
+                ins.bind(2, states[(events + s) % 3]);
+                ins.bind(3, next[s]);
+                ins.bind(4, static_cast<int>(g / 1000));
+                ins.exec();
+                ins.reset();
+                next[s] += g;
+                ++events;
+            }
+            conn.exec("COMMIT");
+        }
+    }
+    conn.exec("ANALYZE");
+    const double load_sec = std::chrono::duration<double>(Clock::now() - l0).count();
+    const int64_t intervals = db.countRows("seat_intervals");
+
+    std::cout << "db: " << db_path << ", " << days << " days, " << seats << " seats, " << events << " events, "
+              << intervals << " intervals (loaded in " << std::fixed << std::setprecision(1) << load_sec << " s)\n";
+    {
+        SQLite::Statement plan(conn, R"(
+            EXPLAIN QUERY PLAN
+            SELECT s.seat_id,
+                COALESCE((SELECT occupied_before_ms + CASE WHEN state IN ('Seated', 'Anomaly')
+                                 THEN MAX(0, ?2 - start_ms) ELSE 0 END
+                          FROM seat_intervals WHERE seat_id = s.seat_id AND end_ms > ?2 ORDER BY end_ms LIMIT 1), 0)
+              - COALESCE((SELECT occupied_before_ms + CASE WHEN state IN ('Seated', 'Anomaly')
+                                 THEN MAX(0, ?1 - start_ms) ELSE 0 END
+                          FROM seat_intervals WHERE seat_id = s.seat_id AND end_ms > ?1 ORDER BY end_ms LIMIT 1), 0)
+            FROM seat_current s)");
+        std::cout << "  occupied-time plan:\n";
+        while (plan.executeStep()) std::cout << "      " << plan.getColumn(3).getString() << "\n";
+    }
+
+    // ranges in the middle of the data, not hour aligned
+    const int64_t mid = ts0 + (days / 2) * day_ms + 1234567;
+    struct Span { const char* name; int64_t ms; };
+    const Span spans[] = {{"1 hour", 3600 * 1000LL}, {"1 day", day_ms}, {"30 days", 30 * day_ms},
+                          {"all", days * day_ms}};
+
+    std::cout << "\n" << std::left << std::setw(10) << "range" << std::right << std::setw(12) << "legacy ms"
+              << std::setw(12) << "minutes ms" << std::setw(12) << "seconds ms" << std::setw(14) << "legacy min"
+              << std::setw(14) << "exact min" << "\n";
+    for (const Span& span : spans) {
+        const int64_t t0 = std::max(ts0 - 1, mid - span.ms / 2);
+        const int64_t t1 = t0 + span.ms;
+        int legacy_min = 0, exact_min = 0;
+        const double legacy_ms = avgMs([&] {
+            SQLite::Statement q(conn, "SELECT SUM(duration_sec) FROM seat_events WHERE seat_id = ? "
+                                      "AND ts_ms BETWEEN ? AND ? AND state IN ('Seated', 'Anomaly')");
+            q.bind(1, "S1");
+            q.bind(2, t0);
+            q.bind(3, t1);
+            if (q.executeStep()) legacy_min = q.getColumn(0).getInt() / 60;
+        });
+        const double minutes_ms = avgMs([&] { exact_min = db.getOccupiedMinutes("S1", t0, t1); });
+        const double seconds_ms = avgMs([&] { db.getOccupiedSeconds(t0, t1); });
+        std::cout << std::left << std::setw(10) << span.name << std::right << std::setprecision(3)
+                  << std::setw(12) << legacy_ms << std::setw(12) << minutes_ms << std::setw(12) << seconds_ms
+                  << std::setw(14) << legacy_min << std::setw(14) << exact_min << "\n";
+    }
+
+    size_t seats_at = 0;
+    const double at_ms = avgMs([&] { seats_at = db.getSeatStatusAt(mid).size(); });
+    std::cout << "\ngetSeatStatusAt: " << std::setprecision(3) << at_ms << " ms (" << seats_at << " seats)" << std::endl;
+    return 0;
+}
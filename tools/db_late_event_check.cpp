@@ -0,0 +1,116 @@
+// db_late_event_check: an event older than the seat's newest one is ignored the same way by every layer
+//
+// 用法: ./db_late_event_check [db=db_late_event_check.db]
+//   - 事件: Seated@T, Seated@T+10s, 迟到的 Unseated@T+5s, 快照 @T+20s
+//   - seat_current / seat_intervals / 小时汇总 / 分区计数 都应视该座位在 [T, T+20s) 一直占用
+//   - seat_intervals 的回填 (schema v4) 须与触发器逐行结果一致
+//   - OccupancyCache: 追赶 (catch-up) 与从 seat_intervals 重新加载后, 结果须与 SQLite 一致
+//   - 任一检查失败时返回 2
+#include "../src/db_core/SeatDatabase.h"
+#include "../src/db_core/DatabaseSchemas.h"
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static bool ok = true;
+
+static void check(const std::string& what, bool pass, const std::string& got) {
+    std::cout << "  " << (pass ? "ok    " : "FAILED") << "  " << what << " (" << got << ")" << std::endl;
+    ok = ok && pass;
+}
+
+static std::vector<std::string> intervalRows(SQLite::Database& conn) {
+    std::vector<std::string> rows;
+    SQLite::Statement q(conn, "SELECT seat_id, state, start_ms, end_ms, occupied_before_ms, last_event_ms "
+                              "FROM seat_intervals ORDER BY seat_id, start_ms, end_ms");
+    while (q.executeStep()) {
+        std::ostringstream r;
+        for (int c = 0; c < 6; ++c) r << q.getColumn(c).getString() << " ";
+        rows.push_back(r.str());
+    }
+    return rows;
+}
+
+int main(int argc, char* argv[]) {
+    std::string db_path = argc > 1 ? argv[1] : "db_late_event_check.db";
+    for (const char* suffix : {"", "-wal", "-shm"}) std::remove((db_path + suffix).c_str());
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+    SeatDatabase& db = SeatDatabase::getInstance(db_path);
+    const bool initialized = db.initialize();
+    std::cout.rdbuf(console);
+    if (!initialized) return 1;
+    db.setOccupancyCacheEnabled(false);   // SQLite layers only
+
+    const int64_t hour = 1700000000000LL / 3600000 * 3600000;
+    const int64_t t = hour + 60000;
+    console = std::cout.rdbuf(sink.rdbuf());
+    db.insertSeat("S1", 0, 0, 10, 10, "Quiet");
+    db.insertSeatEvent("S1", "Seated", t, 0);
+    db.insertSeatEvent("S1", "Seated", t + 10000, 0);
+    db.insertSeatEvent("S1", "Unseated", t + 5000, 0);   // late
+    db.insertSnapshot(t + 20000, "S1", "Seated", 1);
+    db.flushHourlyRollup();
+    std::cout.rdbuf(console);
+
+    std::cout << "late event check" << std::endl;
+    auto current = db.getCurrentSeatStatus();
+    check("seat_current: Seated", current.size() == 1 && current[0].state == "Seated",
+          current.empty() ? "none" : current[0].state);
+
+    auto at = db.getSeatStatusAt(t + 15000);
+    check("seat_intervals at T+15s: Seated", at.size() == 1 && at[0].state == "Seated",
+          at.empty() ? "none" : at[0].state);
+    check("seat_intervals run start: T", at.size() == 1 && at[0].last_update_ms == t,
+          at.empty() ? "none" : std::to_string(at[0].last_update_ms - t));
+
+    auto seconds = db.getOccupiedSeconds(t, t + 20000);
+    check("seat_intervals occupied [T, T+20s): 20 s", seconds["S1"] == 20.0, std::to_string(seconds["S1"]));
+
+    SQLite::Database conn(db_path, SQLite::OPEN_READONLY);
+    const int64_t rollup_ms = conn.execAndGet("SELECT COALESCE(SUM(occupied_ms), 0) FROM seat_agg_hourly "
+                                              "WHERE seat_id = 'S1'").getInt64();
+    check("seat_agg_hourly: 20000 ms", rollup_ms == 20000, std::to_string(rollup_ms));
+
+    auto zones = db.getZoneStatus();
+    check("zone Quiet: 1/1 occupied", zones.size() == 1 && zones[0].seat_occupied == 1,
+          zones.empty() ? "none" : std::to_string(zones[0].seat_occupied) + "/" + std::to_string(zones[0].seat_total));
+
+    // backfill (schema v4) over the same events must give the trigger's rows
+    const auto by_trigger = intervalRows(conn);
+    console = std::cout.rdbuf(sink.rdbuf());
+    db.exec(DatabaseSchemas::INTERVAL_PLAN_V4);
+    db.exec(DatabaseSchemas::CREATE_SEAT_INTERVALS_TRIGGER);
+    std::cout.rdbuf(console);
+    const auto by_backfill = intervalRows(conn);
+    check("backfill == trigger", by_trigger == by_backfill,
+          std::to_string(by_trigger.size()) + " / " + std::to_string(by_backfill.size()) + " rows");
+
+    // OccupancyCache: loaded at initialize() on the empty table, so the events above come in by catch-up
+    const double rate_sqlite = db.getOverallOccupancyRate(hour);
+    db.setOccupancyCacheEnabled(true);
+    seconds = db.getOccupiedSeconds(t, t + 20000);
+    check("cache, catch-up: occupied [T, T+20s) 20 s", seconds["S1"] == 20.0, std::to_string(seconds["S1"]));
+    const double rate_cache = db.getOverallOccupancyRate(hour);
+    check("cache, catch-up: hour rate as SQLite", rate_cache == rate_sqlite,
+          std::to_string(rate_cache) + " / " + std::to_string(rate_sqlite));
+
+    // reload from seat_intervals, then a late event newer than the run start comes in by catch-up
+    console = std::cout.rdbuf(sink.rdbuf());
+    db.initialize();
+    db.insertSeatEvent("S1", "Unseated", t + 8000, 0);   // late
+    std::cout.rdbuf(console);
+    seconds = db.getOccupiedSeconds(t, t + 20000);
+    check("cache, reload + late event: occupied [T, T+20s) 20 s", seconds["S1"] == 20.0,
+          std::to_string(seconds["S1"]));
+    db.setOccupancyCacheEnabled(false);
+    const double seconds_sqlite = db.getOccupiedSeconds(t, t + 20000)["S1"];
+    check("SQLite after the second late event: 20 s", seconds_sqlite == 20.0, std::to_string(seconds_sqlite));
+
+    std::cout << (ok ? "late event check passed" : "late event check FAILED") << std::endl;
+    return ok ? 0 : 2;
+}
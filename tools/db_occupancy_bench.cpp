@@ -0,0 +1,225 @@
+// db_occupancy_bench: occupancy queries from the in-memory OccupancyCache vs. the SQLite path
+//
+// 用法: ./db_occupancy_bench [db=db_occupancy_bench.db] [--days=365] [--seats=100] [--change-sec=900] [--reuse]
+//   - 每个座位平均每 change-sec 秒换一次状态 (间隔随机), 经 SeatDbWriter 写入 (rollup / seat_intervals 同步维护)
+//   - --reuse: 不重新生成, 直接打开已有数据库 (initialize() 的耗时即启动时重建缓存的耗时)
+//   - 每个查询分别在 setOccupancyCacheEnabled(true / false) 下计时, 并比较两边结果
+//       daily   : getDailyHourlyOccupancy(date)       (SQLite: seat_agg_hourly)
+//       rate    : getOverallOccupancyRate(hour)
+//       seconds : getOccupiedSeconds(range)           (SQLite: seat_intervals 前缀和)
+//       minutes : getOccupiedMinutes(S1, range)
+//   - year hourly: 全年 8760 个小时的占用时长, OccupancyCache::occupiedByBucket vs. seat_agg_hourly GROUP BY
+#include "../src/db_core/SeatDatabase.h"
+#include "../src/db_core/OccupancyCache.h"
+#include "../src/db_core/SeatDbWriter.h"
+#include "../src/db_core/TimeUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+static double avgMs(F&& f) {
+    int runs = 0;
+    const auto t0 = Clock::now();
+    double elapsed = 0.0;
+    while (runs < 3 || elapsed < 300.0) {
+        f();
+        ++runs;
+        elapsed = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+    return elapsed / runs;
+}
+
+static double maxDiff(const std::map<std::string, double>& a, const std::map<std::string, double>& b) {
+    double diff = a.size() == b.size() ? 0.0 : INFINITY;
+    for (const auto& kv : a) {
+        auto it = b.find(kv.first);
+        diff = std::max(diff, it == b.end() ? INFINITY : std::fabs(kv.second - it->second));
+    }
+    return diff;
+}
+
+int main(int argc, char* argv[]) {
+    std::string db_path = "db_occupancy_bench.db";
+    int days = 365;
+    int seats = 100;
+    int change_sec = 900;
+    bool reuse = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a.rfind("--days=", 0) == 0) days = std::atoi(a.c_str() + 7);
+        else if (a.rfind("--seats=", 0) == 0) seats = std::atoi(a.c_str() + 8);
+        else if (a.rfind("--change-sec=", 0) == 0) change_sec = std::atoi(a.c_str() + 13);
+        else if (a == "--reuse") reuse = true;
+        else db_path = a;
+    }
+    if (db_path == ":memory:") {
+        std::cout << "db_occupancy_bench needs a database file" << std::endl;
+        return 1;
+    }
+    if (reuse && !std::ifstream(db_path)) reuse = false;
+    if (!reuse) {
+        for (const char* suffix : {"", "-wal", "-shm"}) std::remove((db_path + suffix).c_str());
+    }
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+    SeatDatabase& db = SeatDatabase::getInstance(db_path);
+    const auto i0 = Clock::now();
+    if (!db.initialize()) {
+        std::cout.rdbuf(console);
+        return 1;
+    }
+    const double init_sec = std::chrono::duration<double>(Clock::now() - i0).count();
+
+    // local midnight; seat s changes state after a random gap, events in ts order
+    const std::string first_date = "2025-01-01";
+    const int64_t ts0 = TimeUtils::toEpochMs(first_date + " 00:00:00");
+    const int64_t day_ms = 24 * 3600 * 1000LL;
+    double load_sec = 0.0;
+    if (!reuse) {
+        for (int s = 1; s <= seats; ++s) db.insertSeat("S" + std::to_string(s), 10 * s, 10, 80, 80);
+        const char* states[] = {"Seated", "Unseated", "Seated", "Unseated", "Anomaly", "Unseated"};
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<int64_t> gap(1000, 2LL * change_sec * 1000);
+        std::vector<int64_t> next(seats);
+        std::vector<int> step(seats, 0);
+        for (int s = 0; s < seats; ++s) next[s] = ts0 + gap(rng) / 2;
+        const int64_t end_ms = ts0 + days * day_ms;
+        const auto l0 = Clock::now();
+        {
+            SeatDbWriter writer(db);
+            for (;;) {
+                const int s = static_cast<int>(std::min_element(next.begin(), next.end()) - next.begin());
+                if (next[s] >= end_ms) break;
+                const int64_t g = gap(rng);
+                writer.insertSeatEvent("S" + std::to_string(s + 1), states[step[s]++ % 6], next[s], static_cast<int>(g / 1000));
+                next[s] += g;
+            }
+            writer.flush();
+        }
+        db.flushHourlyRollup();
+        db.exec("ANALYZE");
+        load_sec = std::chrono::duration<double>(Clock::now() - l0).count();
+    }
+    const int64_t events = db.countRows("seat_events");
+    const int64_t intervals = db.countRows("seat_intervals");
+
+    // first query folds every event written since initialize() into the cache
+    const auto c0 = Clock::now();
+    db.getOverallOccupancyRate(ts0);
+    const double catch_up_ms = std::chrono::duration<double, std::milli>(Clock::now() - c0).count();
+    std::cout.rdbuf(console);
+
+    std::cout << "db: " << db_path << ", " << days << " days, " << seats << " seats, " << events << " events, "
+              << intervals << " intervals\n" << std::fixed << std::setprecision(1);
+    if (reuse) std::cout << "  initialize() incl. cache rebuild: " << init_sec << " s\n";
+    else std::cout << "  generated in " << load_sec << " s; first query caught the cache up in " << catch_up_ms << " ms\n";
+
+    const std::string mid_date = TimeUtils::fromEpochMs(ts0 + (days / 2) * day_ms).substr(0, 10);
+    const std::string last_date = TimeUtils::fromEpochMs(ts0 + (days - 1) * day_ms).substr(0, 10);
+    const int64_t mid = ts0 + (days / 2) * day_ms + 1234567;
+
+    std::cout << "\n" << std::left << std::setw(28) << "query" << std::right << std::setw(12) << "cache ms"
+              << std::setw(12) << "sqlite ms" << std::setw(14) << "max |diff|" << "\n";
+    auto row = [](const std::string& name, double cache_ms, double sqlite_ms, double diff) {
+        std::cout << std::left << std::setw(28) << name << std::right << std::setprecision(3) << std::setw(12) << cache_ms
+                  << std::setw(12) << sqlite_ms << std::setprecision(6) << std::setw(14) << diff << "\n";
+    };
+
+    for (const std::string& date : {mid_date, last_date}) {
+        std::vector<double> on, off;
+        db.setOccupancyCacheEnabled(true);
+        const double on_ms = avgMs([&] { on = db.getDailyHourlyOccupancy(date); });
+        db.setOccupancyCacheEnabled(false);
+        const double off_ms = avgMs([&] { off = db.getDailyHourlyOccupancy(date); });
+        double diff = 0.0;
+        for (int h = 0; h < 24; ++h) diff = std::max(diff, std::fabs(on[h] - off[h]));
+        row("daily " + date, on_ms, off_ms, diff);
+    }
+    {
+        const int64_t hour = HourlyRollup::hourOf(mid);
+        double on = 0.0, off = 0.0;
+        db.setOccupancyCacheEnabled(true);
+        const double on_ms = avgMs([&] { on = db.getOverallOccupancyRate(hour); });
+        db.setOccupancyCacheEnabled(false);
+        const double off_ms = avgMs([&] { off = db.getOverallOccupancyRate(hour); });
+        row("rate (1 hour)", on_ms, off_ms, std::fabs(on - off));
+    }
+    struct Span { const char* name; int64_t ms; };
+    const Span spans[] = {{"1 day", day_ms}, {"30 days", 30 * day_ms}, {"all", days * day_ms}};
+    for (const Span& span : spans) {
+        const int64_t t0 = std::max(ts0, mid - span.ms / 2);
+        const int64_t t1 = t0 + span.ms;
+        std::map<std::string, double> on, off;
+        db.setOccupancyCacheEnabled(true);
+        const double on_ms = avgMs([&] { on = db.getOccupiedSeconds(t0, t1); });
+        db.setOccupancyCacheEnabled(false);
+        const double off_ms = avgMs([&] { off = db.getOccupiedSeconds(t0, t1); });
+        row(std::string("seconds ") + span.name, on_ms, off_ms, maxDiff(on, off));
+
+        int on_min = 0, off_min = 0;
+        db.setOccupancyCacheEnabled(true);
+        const double on_min_ms = avgMs([&] { on_min = db.getOccupiedMinutes("S1", t0, t1); });
+        db.setOccupancyCacheEnabled(false);
+        const double off_min_ms = avgMs([&] { off_min = db.getOccupiedMinutes("S1", t0, t1); });
+        row(std::string("minutes S1 ") + span.name, on_min_ms, off_min_ms, std::abs(on_min - off_min));
+    }
+    db.setOccupancyCacheEnabled(true);
+
+    // whole data set as an hourly series: the columns directly vs. the rollup table
+    {
+        SQLite::Database conn(db_path, SQLite::OPEN_READONLY);
+        const auto b0 = Clock::now();
+        OccupancyCache cache;
+        {
+            SQLite::Statement runs(conn, "SELECT seat_id, state, start_ms, last_event_ms FROM seat_intervals "
+                                         "ORDER BY seat_id, end_ms");
+            while (runs.executeStep()) {
+                cache.append(runs.getColumn(0).getString(), runs.getColumn(1).getString(), runs.getColumn(2).getInt64(),
+                             runs.getColumn(3).getInt64());
+            }
+        }
+        const double build_ms = std::chrono::duration<double, std::milli>(Clock::now() - b0).count();
+        const int64_t clock_ms = conn.execAndGet("SELECT MAX(ts_ms) FROM seat_current").getInt64();
+        const int hours = days * 24;
+
+        std::vector<int64_t> columns, rollup(hours, 0);
+        const double columns_ms = avgMs([&] {
+            columns.clear();
+            cache.occupiedByBucket(ts0, HourlyRollup::kHourMs, hours, clock_ms, {}, 1, columns);
+        });
+        const double rollup_ms = avgMs([&] {
+            std::fill(rollup.begin(), rollup.end(), 0);
+            SQLite::Statement q(conn, "SELECT hour_ms, SUM(occupied_ms) FROM seat_agg_hourly "
+                                      "WHERE hour_ms >= ? AND hour_ms < ? GROUP BY hour_ms");
+            q.bind(1, ts0);
+            q.bind(2, ts0 + hours * HourlyRollup::kHourMs);
+            while (q.executeStep()) {
+                rollup[(q.getColumn(0).getInt64() - ts0) / HourlyRollup::kHourMs] = q.getColumn(1).getInt64();
+            }
+        });
+        int64_t differing = 0;
+        for (int h = 0; h < hours; ++h) differing += columns[h] != rollup[h];
+        std::cout << "\nyear hourly (" << hours << " hours, all seats)\n"
+                  << std::setprecision(3)
+                  << "  columns  : " << std::setw(10) << columns_ms << " ms\n"
+                  << "  rollup   : " << std::setw(10) << rollup_ms << " ms (seat_agg_hourly GROUP BY hour_ms)\n"
+                  << "  hours differing: " << differing << "\n"
+                  << "  cache: " << cache.runCount() << " runs, " << cache.bytes() / (1024.0 * 1024.0)
+                  << " MiB, built from seat_intervals in " << std::setprecision(1) << build_ms << " ms" << std::endl;
+    }
+    return 0;
+}
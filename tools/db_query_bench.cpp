@@ -0,0 +1,180 @@
+// db_query_bench: EXPLAIN QUERY PLAN and latency of the SeatDatabase range queries, without / with the index plan
+//
+// 用法: ./db_query_bench [db=db_query_bench.db] [--events=2000000] [--alerts=200000] [--seats=100]
+//   - seat_events: seats 个座位每秒一行, 共 events 行; alerts: 1% 未处理, 0.5% 未关闭
+//   - 先删掉全部 idx_* 索引测一遍 (before), 再按 initialize() 建好的原样重建测一遍 (after)
+//   - 每条查询打印 EXPLAIN QUERY PLAN, 以及 SeatDatabase 对应方法的平均延迟
+#include "../src/db_core/SeatDatabase.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchQuery {
+    const char* name;
+    std::string sql;                            // same SQL as the SeatDatabase method, for EXPLAIN
+    std::vector<int64_t> binds;                 // integer parameters; "S1" is bound first when needs_seat
+    bool needs_seat;
+};
+
+template <typename F>
+static double avgMs(F&& f) {
+    int runs = 0;
+    const auto t0 = Clock::now();
+    double elapsed = 0.0;
+    while (runs < 3 || elapsed < 300.0) {
+        f();
+        ++runs;
+        elapsed = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+    return elapsed / runs;
+}
+
+static void explain(SQLite::Database& db, const BenchQuery& q) {
+    SQLite::Statement plan(db, "EXPLAIN QUERY PLAN " + q.sql);
+    int idx = 1;
+    if (q.needs_seat) plan.bind(idx++, "S1");
+    for (int64_t v : q.binds) plan.bind(idx++, v);
+    while (plan.executeStep()) std::cout << "      " << plan.getColumn(3).getString() << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string db_path = "db_query_bench.db";
+    int64_t events = 2000000;
+    int64_t alerts = 200000;
+    int seats = 100;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a.rfind("--events=", 0) == 0) events = std::atoll(a.c_str() + 9);
+        else if (a.rfind("--alerts=", 0) == 0) alerts = std::atoll(a.c_str() + 9);
+        else if (a.rfind("--seats=", 0) == 0) seats = std::atoi(a.c_str() + 8);
+        else db_path = a;
+    }
+    if (db_path == ":memory:") {
+        std::cout << "db_query_bench needs a database file (the loader uses its own connection)" << std::endl;
+        return 1;
+    }
+    for (const char* suffix : {"", "-wal", "-shm"}) std::remove((db_path + suffix).c_str());
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+    SeatDatabase& db = SeatDatabase::getInstance(db_path);
+    if (!db.initialize()) {
+        std::cout.rdbuf(console);
+        return 1;
+    }
+    for (int s = 1; s <= seats; ++s) db.insertSeat("S" + std::to_string(s), 10 * s, 10, 80, 80);
+    std::cout.rdbuf(console);
+
+    // bulk load through a second connection, 100k rows per transaction
+    SQLite::Database conn(db_path, SQLite::OPEN_READWRITE);
+    conn.exec("PRAGMA synchronous = NORMAL");
+    const int64_t ts0 = 1700000000000LL;
+    const char* states[] = {"Seated", "Unseated", "Anomaly"};
+    {
+        SQLite::Statement ins(conn, "INSERT INTO seat_events (seat_id, state, ts_ms, duration_sec) VALUES (?, ?, ?, ?)");
+        for (int64_t i = 0; i < events;) {
+            conn.exec("BEGIN");
+            for (int64_t end = std::min(events, i + 100000); i < end; ++i) {
+                ins.bind(1, "S" + std::to_string(i % seats + 1));
+                ins.bind(2, states[(i / seats + i % 7) % 3]);
+                ins.bind(3, ts0 + (i / seats) * 1000);
+                ins.bind(4, static_cast<int>(i % 600));
+                ins.exec();
+                ins.reset();
+            }
+            conn.exec("COMMIT");
+        }
+        SQLite::Statement alert(conn, "INSERT INTO alerts (alert_id, seat_id, alert_type, alert_desc, ts_ms, is_processed, "
+                                      "last_ts_ms, duration_sec, resolved_ts_ms) VALUES (?, ?, 'AnomalyOccupied', '', ?, ?, ?, 60, ?)");
+        conn.exec("BEGIN");
+        for (int64_t i = 0; i < alerts; ++i) {
+            const int64_t ts = ts0 + i * 10000;
+            alert.bind(1, "A" + std::to_string(i));
+            alert.bind(2, "S" + std::to_string(i % seats + 1));
+            alert.bind(3, ts);
+            alert.bind(4, i % 100 == 0 ? 0 : 1);
+            alert.bind(5, ts + 60000);
+            alert.bind(6, i % 200 == 0 ? int64_t(0) : ts + 60000);
+            alert.exec();
+            alert.reset();
+        }
+        conn.exec("COMMIT");
+    }
+
+    const int64_t hour_ms = ts0 + (events / seats / 2) * 1000;   // an hour in the middle of the data
+    const std::vector<BenchQuery> queries = {
+        {"getOccupiedMinutes", R"(
+            SELECT occupied_before_ms FROM seat_intervals
+            WHERE seat_id = ? AND end_ms > ? ORDER BY end_ms LIMIT 1)",
+         {hour_ms}, true},
+        {"getOverallOccupancyRate", R"(
+            SELECT hour_ms, SUM(occupied_ms) FROM seat_agg_hourly
+            WHERE hour_ms >= ? AND hour_ms < ? GROUP BY hour_ms)",
+         {hour_ms, hour_ms + 3600000}, false},
+        {"getUnprocessedAlerts", "SELECT alert_id, seat_id, alert_type, alert_desc, ts_ms, is_processed "
+                                 "FROM alerts WHERE is_processed = 0 ORDER BY ts_ms DESC", {}, false},
+        {"getOpenAlerts", "SELECT alert_id, seat_id, alert_type, alert_desc, ts_ms "
+                          "FROM alerts WHERE resolved_ts_ms = 0 ORDER BY ts_ms", {}, false},
+    };
+    auto run = [&](const BenchQuery& q) -> double {
+        std::string name = q.name;
+        std::ostringstream quiet;
+        std::streambuf* out = std::cout.rdbuf(quiet.rdbuf());
+        double ms = 0.0;
+        if (name == "getOccupiedMinutes") ms = avgMs([&] { db.getOccupiedMinutes("S1", hour_ms, hour_ms + 3600000); });
+        else if (name == "getOverallOccupancyRate") ms = avgMs([&] { db.getOverallOccupancyRate(hour_ms); });
+        else if (name == "getUnprocessedAlerts") ms = avgMs([&] { db.getUnprocessedAlerts(); });
+        else if (name == "getOpenAlerts") ms = avgMs([&] { db.getOpenAlerts(); });
+        std::cout.rdbuf(out);
+        return ms;
+    };
+
+    // the plan as initialize() created it
+    std::vector<std::pair<std::string, std::string>> plan;
+    {
+        SQLite::Statement idx(conn, "SELECT name, sql FROM sqlite_master WHERE type = 'index' AND name LIKE 'idx_%'");
+        while (idx.executeStep()) plan.emplace_back(idx.getColumn(0).getString(), idx.getColumn(1).getString());
+    }
+
+    std::cout << "db: " << db_path << ", " << events << " events, " << alerts << " alerts, " << seats << " seats\n";
+    std::vector<double> before, after;
+    for (const auto& p : plan) conn.exec("DROP INDEX " + p.first);
+    conn.exec("ANALYZE");
+    std::cout << "\n[before] no secondary indexes\n";
+    for (const auto& q : queries) {
+        std::cout << "  " << q.name << "\n";
+        explain(conn, q);
+        before.push_back(run(q));
+    }
+
+    for (const auto& p : plan) conn.exec(p.second);
+    conn.exec("ANALYZE");
+    std::cout << "\n[after] index plan:";
+    for (const auto& p : plan) std::cout << " " << p.first;
+    std::cout << "\n";
+    for (const auto& q : queries) {
+        std::cout << "  " << q.name << "\n";
+        explain(conn, q);
+        after.push_back(run(q));
+    }
+
+    std::cout << "\n" << std::left << std::setw(26) << "query" << std::right << std::setw(12) << "before ms"
+              << std::setw(12) << "after ms" << std::setw(10) << "speedup" << "\n";
+    for (size_t i = 0; i < queries.size(); ++i) {
+        std::cout << std::left << std::setw(26) << queries[i].name << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(12) << before[i] << std::setw(12) << after[i]
+                  << std::setprecision(1) << std::setw(9) << (after[i] > 0 ? before[i] / after[i] : 0.0) << "x\n";
+    }
+    std::cout << std::flush;
+    return 0;
+}
@@ -0,0 +1,86 @@
+// db_retention: retention report / pass on a seating database (SeatDbRetention)
+//
+// 用法: ./db_retention <db> [--run] [--enable-incremental-vacuum] [--raw-days=7] [--downsample-sec=60]
+//                      [--snapshot-days=90] [--event-days=365] [--batch=2000] [--pause-ms=20] [--vacuum-pages=2000]
+//   - 默认只做 dry run: 打印将被降采样 / 删除的行数和估计字节数, 不改数据库
+//   - --run: 执行一遍 (小批量事务), 打印结果和文件大小变化
+//   - --enable-incremental-vacuum: 老数据库一次性切到 auto_vacuum = INCREMENTAL (完整 VACUUM, 期间阻塞写入)
+#include "../src/db_core/SeatDatabase.h"
+#include "../src/db_core/SeatDbRetention.h"
+#include "../src/db_core/TimeUtils.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+static int64_t fileBytes(const std::string& path) {
+    int64_t total = 0;
+    for (const char* suffix : {"", "-wal"}) {
+        std::ifstream f(path + suffix, std::ios::binary | std::ios::ate);
+        if (f) total += static_cast<int64_t>(f.tellg());
+    }
+    return total;
+}
+
+static void print(const RetentionReport& r) {
+    std::cout << (r.dry_run ? "dry run" : "pass") << " at data clock " << TimeUtils::fromEpochMs(r.clock_ms) << "\n"
+              << "  snapshots compacted : " << r.snapshots_compacted << "\n"
+              << "  snapshots deleted   : " << r.snapshots_deleted << "\n"
+              << "  events deleted      : " << r.events_deleted << "\n";
+    if (r.dry_run) {
+        std::cout << "  bytes (estimate)    : " << (r.bytes_estimate >= 0 ? std::to_string(r.bytes_estimate) : "n/a (no dbstat)") << "\n"
+                  << "  free pages now      : " << r.freelist_bytes << " bytes\n";
+    } else {
+        std::cout << "  bytes vacuumed      : " << r.freelist_bytes << "\n";
+    }
+    std::cout << "  auto_vacuum         : " << r.auto_vacuum << "\n"
+              << "  took                : " << std::fixed << std::setprecision(3) << r.seconds << " s" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: db_retention <db> [--run] [--enable-incremental-vacuum] [--raw-days=N] [--downsample-sec=N]\n"
+                     "                    [--snapshot-days=N] [--event-days=N] [--batch=N] [--pause-ms=N] [--vacuum-pages=N]"
+                  << std::endl;
+        return 1;
+    }
+    const std::string db_path = argv[1];
+    RetentionPolicy policy;
+    bool run = false;
+    bool enable_vacuum = false;
+    for (int i = 2; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--run") run = true;
+        else if (a == "--enable-incremental-vacuum") enable_vacuum = true;
+        else if (a.rfind("--raw-days=", 0) == 0) policy.snapshot_raw_days = std::atoi(a.c_str() + 11);
+        else if (a.rfind("--downsample-sec=", 0) == 0) policy.snapshot_downsample_sec = std::atoi(a.c_str() + 17);
+        else if (a.rfind("--snapshot-days=", 0) == 0) policy.snapshot_keep_days = std::atoi(a.c_str() + 16);
+        else if (a.rfind("--event-days=", 0) == 0) policy.event_keep_days = std::atoi(a.c_str() + 13);
+        else if (a.rfind("--batch=", 0) == 0) policy.batch_rows = static_cast<size_t>(std::atoll(a.c_str() + 8));
+        else if (a.rfind("--pause-ms=", 0) == 0) policy.batch_pause_ms = std::atoi(a.c_str() + 11);
+        else if (a.rfind("--vacuum-pages=", 0) == 0) policy.vacuum_pages = std::atoi(a.c_str() + 15);
+    }
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+    SeatDatabase& db = SeatDatabase::getInstance(db_path);
+    const bool ok = db.initialize();
+    std::cout.rdbuf(console);
+    if (!ok) return 1;
+
+    SeatDbRetention retention(db, policy);
+    if (enable_vacuum && !retention.enableIncrementalVacuum()) return 1;
+
+    const int64_t before = fileBytes(db_path);
+    print(retention.preview());
+    if (run) {
+        print(retention.runOnce());
+        db.exec("PRAGMA wal_checkpoint(TRUNCATE)");
+        const int64_t after = fileBytes(db_path);
+        std::cout << "file: " << before << " -> " << after << " bytes" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+// db_rollup_bench: getDailyHourlyOccupancy from the hourly rollup vs. the old 24 x COUNT(DISTINCT) over seat_events
+//
+// 用法: ./db_rollup_bench [db=db_rollup_bench.db] [--events=1000000] [--seats=100]
+//   - 事件经 SeatDbWriter 写入 (和 judger 一样走 writeSeatEvent, rollup 随写随折叠), 每个座位每 30 s 换一次状态
+//   - daily : getDailyHourlyOccupancy(), 一次 seat_agg_hourly 范围查询
+//   - legacy: 原来的实现, 每小时一条 COUNT(DISTINCT seat_id) 扫 seat_events, 共 24 条
+//   - check : 用 seat_events 重算各小时占用时长, 和 seat_agg_hourly 比较 (跨小时的区间要拆开)
+#include "../src/db_core/SeatDatabase.h"
+#include "../src/db_core/SeatDbWriter.h"
+#include "../src/db_core/TimeUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+static double avgMs(F&& f) {
+    int runs = 0;
+    const auto t0 = Clock::now();
+    double elapsed = 0.0;
+    while (runs < 3 || elapsed < 300.0) {
+        f();
+        ++runs;
+        elapsed = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+    return elapsed / runs;
+}
+
+int main(int argc, char* argv[]) {
+    std::string db_path = "db_rollup_bench.db";
+    int64_t events = 1000000;
+    int seats = 100;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a.rfind("--events=", 0) == 0) events = std::atoll(a.c_str() + 9);
+        else if (a.rfind("--seats=", 0) == 0) seats = std::atoi(a.c_str() + 8);
+        else db_path = a;
+    }
+    if (db_path == ":memory:") {
+        std::cout << "db_rollup_bench needs a database file (the legacy query uses its own connection)" << std::endl;
+        return 1;
+    }
+    for (const char* suffix : {"", "-wal", "-shm"}) std::remove((db_path + suffix).c_str());
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+    SeatDatabase& db = SeatDatabase::getInstance(db_path);
+    if (!db.initialize()) {
+        std::cout.rdbuf(console);
+        return 1;
+    }
+    for (int s = 1; s <= seats; ++s) db.insertSeat("S" + std::to_string(s), 10 * s, 10, 80, 80);
+
+    // events start at local midnight; seat s changes state every 30 s, offset by s seconds
+    const std::string date = "2025-12-02";
+    const int64_t ts0 = TimeUtils::toEpochMs(date + " 00:00:00");
+    const char* states[] = {"Seated", "Unseated", "Anomaly", "Unseated"};
+    const auto l0 = Clock::now();
+    {
+        SeatDbWriter writer(db);
+        for (int64_t i = 0; i < events; ++i) {
+            const int s = static_cast<int>(i % seats);
+            const int64_t step = i / seats;
+            writer.insertSeatEvent("S" + std::to_string(s + 1), states[(step + s) % 4], ts0 + step * 30000 + s * 1000, 30);
+        }
+        writer.flush();
+    }
+    db.flushHourlyRollup();
+    const double load_sec = std::chrono::duration<double>(Clock::now() - l0).count();
+    std::cout.rdbuf(console);
+
+    SQLite::Database conn(db_path, SQLite::OPEN_READONLY);
+    auto legacyDaily = [&] {
+        std::vector<double> rates(24, 0.0);
+        for (int h = 0; h < 24; ++h) {
+            SQLite::Statement q(conn, "SELECT COUNT(DISTINCT seat_id) FROM seat_events "
+                                      "WHERE ts_ms >= ? AND ts_ms < ? AND state IN ('Seated', 'Anomaly')");
+            q.bind(1, static_cast<int64_t>(ts0 + h * 3600000LL));
+            q.bind(2, static_cast<int64_t>(ts0 + (h + 1) * 3600000LL));
+            if (q.executeStep()) rates[h] = static_cast<double>(q.getColumn(0).getInt()) / seats;
+        }
+        return rates;
+    };
+
+    // recompute the buckets from the raw events (occupied from an event until the seat's next event)
+    std::map<std::pair<int64_t, std::string>, int64_t> expected;
+    int64_t clock_ms = 0;
+    {
+        SQLite::Statement q(conn, "SELECT seat_id, state, ts_ms FROM seat_events ORDER BY seat_id, ts_ms");
+        std::string seat;
+        int64_t since = 0;
+        bool occupied = false;
+        auto fold = [&](int64_t to) {
+            for (int64_t from = since; occupied && from < to;) {
+                const int64_t hour = HourlyRollup::hourOf(from);
+                const int64_t end = std::min(to, hour + HourlyRollup::kHourMs);
+                expected[{hour, seat}] += end - from;
+                from = end;
+            }
+        };
+        std::vector<std::pair<std::string, int64_t>> open;
+        while (q.executeStep()) {
+            const std::string id = q.getColumn(0).getString();
+            const int64_t ts = q.getColumn(2).getInt64();
+            if (id != seat) {
+                if (occupied) open.emplace_back(seat, since);
+                seat = id;
+                occupied = false;
+            }
+            fold(ts);
+            occupied = HourlyRollup::isOccupied(q.getColumn(1).getString());
+            since = ts;
+            clock_ms = std::max(clock_ms, ts);
+        }
+        if (occupied) open.emplace_back(seat, since);
+        for (const auto& o : open) {
+            seat = o.first;
+            since = o.second;
+            occupied = true;
+            fold(clock_ms);
+        }
+    }
+    int64_t mismatched = 0, rows = 0;
+    {
+        SQLite::Statement q(conn, "SELECT hour_ms, seat_id, occupied_ms FROM seat_agg_hourly");
+        std::map<std::pair<int64_t, std::string>, int64_t> got;
+        while (q.executeStep()) {
+            got[{q.getColumn(0).getInt64(), q.getColumn(1).getString()}] = q.getColumn(2).getInt64();
+            ++rows;
+        }
+        for (const auto& e : expected) mismatched += (got[e.first] != e.second);
+        for (const auto& g : got) mismatched += (g.second != 0 && expected.find(g.first) == expected.end());
+    }
+
+    std::vector<double> daily, legacy;
+    const double daily_ms = avgMs([&] { daily = db.getDailyHourlyOccupancy(date); });
+    const double legacy_ms = avgMs([&] { legacy = legacyDaily(); });
+
+    std::cout << "db: " << db_path << ", " << events << " events, " << seats << " seats, loaded in "
+              << std::fixed << std::setprecision(1) << load_sec << " s\n"
+              << "  seat_agg_hourly rows: " << rows << ", buckets differing from seat_events: " << mismatched << "\n"
+              << std::setprecision(3)
+              << "  daily  (rollup)      : " << std::setw(10) << daily_ms << " ms\n"
+              << "  legacy (24 x DISTINCT): " << std::setw(9) << legacy_ms << " ms\n"
+              << "  hour  rollup  legacy (seats with any occupied event)\n";
+    for (int h = 0; h < 24; ++h) {
+        std::cout << "  " << std::setw(4) << h << std::setw(8) << daily[h] << std::setw(8) << legacy[h] << "\n";
+    }
+    std::cout << std::flush;
+    return 0;
+}
@@ -0,0 +1,90 @@
+// judger_bench: in-process SeatFrameState path vs JSONL adapter path
+//
+// 用法: ./judger_bench [seats=150] [frames=2000]
+//   - 同一组合成帧分别喂给两个 SeatStateJudger (均不连接数据库, 关闭逐座位日志)
+//   - jsonl : seatFrameStatesToJsonLine -> parseJsonlLine -> processFrameBatch (内存内, 不含磁盘 I/O)
+//   - struct: processFrame(const std::vector<vision::SeatFrameState>&)
+//   - 结束时比较两条路径标记的待存帧集合, 确认判定结果一致
+#include <seat_state_judger.hpp>
+#include <data_structures.hpp>
+#include "seatui/vision/Types.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static std::vector<std::vector<vision::SeatFrameState>> makeFrames(int seats, int frames) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> flip(0, 99);
+    std::vector<vision::SeatOccupancyState> cur(seats, vision::SeatOccupancyState::FREE);
+
+    std::vector<std::vector<vision::SeatFrameState>> out(frames);
+    const int64_t t0 = 1700000000000LL;
+    for (int f = 0; f < frames; ++f) {
+        out[f].resize(seats);
+        for (int s = 0; s < seats; ++s) {
+            if (flip(gen) < 3) cur[s] = static_cast<vision::SeatOccupancyState>(flip(gen) % 3);  // ~3% 的座位每帧变化
+            auto& st = out[f][s];
+            st.seat_id = s + 1;
+            st.ts_ms = t0 + f * 500LL;
+            st.frame_index = f;
+            st.occupancy_state = cur[s];
+            st.has_person = cur[s] == vision::SeatOccupancyState::PERSON;
+            st.has_object = cur[s] == vision::SeatOccupancyState::OBJECT_ONLY;
+            st.person_count = st.has_person ? 1 : 0;
+            st.object_count = st.has_object ? 1 : 0;
+            st.person_conf_max = st.has_person ? 0.8f : 0.f;
+            st.object_conf_max = st.has_object ? 0.7f : 0.f;
+            st.seat_roi = cv::Rect(10 * s, 10, 80, 80);
+        }
+    }
+    return out;
+}
+
+int main(int argc, char* argv[]) {
+    int seats  = argc > 1 ? std::atoi(argv[1]) : 150;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 2000;
+    if (seats <= 0 || frames <= 0) {
+        std::cout << "Usage: judger_bench [seats=150] [frames=2000]" << std::endl;
+        return 1;
+    }
+
+    auto data = makeFrames(seats, frames);
+
+    // 1. JSONL adapter path
+    SeatStateJudger j_jsonl(nullptr);
+    j_jsonl.setVerbose(false);
+    std::vector<A2B_Data> frame_a2b;
+    std::vector<json> frame_j;
+    auto t0 = std::chrono::steady_clock::now();
+    for (auto& states : data) {
+        std::string line = vision::seatFrameStatesToJsonLine(states, states.front().ts_ms, states.front().frame_index, "", "");
+        if (j_jsonl.parseJsonlLine(line, frame_a2b, frame_j)) j_jsonl.processFrameBatch(frame_a2b, frame_j);
+    }
+    double ms_jsonl = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    // 2. struct path
+    SeatStateJudger j_struct(nullptr);
+    j_struct.setVerbose(false);
+    t0 = std::chrono::steady_clock::now();
+    for (auto& states : data) j_struct.processFrame(states);
+    double ms_struct = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    auto a = j_jsonl.getNeedStoreFrameIndexes();
+    auto b = j_struct.getNeedStoreFrameIndexes();
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+
+    const double seat_frames = static_cast<double>(seats) * frames;
+    std::cout << std::fixed << std::setprecision(2)
+              << "seats=" << seats << " frames=" << frames << "\n"
+              << "  jsonl : " << std::setw(10) << ms_jsonl  << " ms  " << std::setw(12) << seat_frames / (ms_jsonl  / 1000.0) << " seat-frames/s\n"
+              << "  struct: " << std::setw(10) << ms_struct << " ms  " << std::setw(12) << seat_frames / (ms_struct / 1000.0) << " seat-frames/s\n"
+              << "  speedup: " << (ms_struct > 0 ? ms_jsonl / ms_struct : 0.0) << "x\n"
+              << "  results " << (a == b ? "match" : "DIFFER") << std::endl;
+    return a == b ? 0 : 2;
+}
@@ -0,0 +1,66 @@
+// judger_debounce_check: a debounced transition is stamped at the frame its candidate was first seen
+//
+// 用法: ./judger_debounce_check
+//   - 一个座位, 每秒一帧, 去抖开启 (进入驻留 2 s, 离开驻留 5 s)
+//   - 空 @0..1s, 有人 @2..8s (第 5 s 一帧闪断), 空 @9..16s
+//   - 期望事件: Unseated@0, Seated@2s (第 4 s 确认), Unseated@9s (第 14 s 确认); 闪断不产生事件
+//   - 不连接数据库; 不一致时返回 2
+#include <seat_state_judger.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct Expected {
+    std::string state;
+    int64_t ts_ms;
+};
+
+int main() {
+    SeatStateJudger judger(nullptr);
+    judger.setVerbose(false);
+    JudgerDebounceConfig cfg;
+    cfg.enable = true;
+    cfg.enter_dwell_ms = 2000;
+    cfg.exit_dwell_ms = 5000;
+    judger.setDebounce(cfg);
+
+    const int64_t t0 = 1700000000000LL;
+    std::vector<B2C_SeatEvent> events;
+    for (int sec = 0; sec <= 16; ++sec) {
+        const bool person = sec >= 2 && sec <= 8 && sec != 5;
+        SeatObservation obs;
+        obs.seat_id = "S1";
+        obs.frame_id = sec;
+        obs.ts_ms = t0 + sec * 1000LL;
+        obs.person_count = person ? 1 : 0;
+        obs.occupancy = person ? vision::SeatOccupancyState::PERSON : vision::SeatOccupancyState::FREE;
+
+        B2CD_State state;
+        state.seat_id = obs.seat_id;
+        std::vector<B2CD_Alert> alerts;
+        std::optional<B2C_SeatSnapshot> snapshot;
+        std::optional<B2C_SeatEvent> event;
+        judger.judgeSeat(obs, state, alerts, snapshot, event);
+        if (event) events.push_back(*event);
+    }
+
+    const std::vector<Expected> expected = {
+        {"Unseated", t0}, {"Seated", t0 + 2000}, {"Unseated", t0 + 9000}};
+    bool ok = events.size() == expected.size();
+    for (size_t i = 0; i < std::max(events.size(), expected.size()); ++i) {
+        const bool have = i < events.size(), want = i < expected.size();
+        const bool match = have && want && events[i].state == expected[i].state && events[i].ts_ms == expected[i].ts_ms;
+        std::cout << "  " << (match ? "ok    " : "FAILED") << "  event " << i << ": ";
+        if (have) std::cout << events[i].state << " @" << (events[i].ts_ms - t0) << " ms";
+        else std::cout << "none";
+        if (want) std::cout << " (expected " << expected[i].state << " @" << (expected[i].ts_ms - t0) << " ms)";
+        std::cout << std::endl;
+        ok = ok && match;
+    }
+
+    std::cout << (ok ? "debounce check passed" : "debounce check FAILED") << std::endl;
+    return ok ? 0 : 2;
+}
@@ -0,0 +1,94 @@
+// judger_reshard_check: seat state survives SeatStateJudger::setShardCount changes
+//
+// 用法: ./judger_reshard_check [seats=200] [frames=400]
+//   - 参考: 顺序判定全部帧
+//   - 检查: 前半段 2 分片, 切到 4 分片再判后半段, 最后切回顺序; 每次切换前后座位状态表须与参考一致
+//   - 不连接数据库; 不一致时返回 2
+#include <seat_state_judger.hpp>
+#include "seatui/vision/Types.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static std::vector<std::vector<vision::SeatFrameState>> makeFrames(int seats, int frames) {
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> flip(0, 99);
+    std::vector<vision::SeatOccupancyState> cur(seats, vision::SeatOccupancyState::FREE);
+
+    std::vector<std::vector<vision::SeatFrameState>> out(frames);
+    const int64_t t0 = 1700000000000LL;
+    for (int f = 0; f < frames; ++f) {
+        out[f].resize(seats);
+        for (int s = 0; s < seats; ++s) {
+            if (flip(gen) < 5) cur[s] = static_cast<vision::SeatOccupancyState>(flip(gen) % 3);
+            auto& st = out[f][s];
+            st.seat_id = s + 1;
+            st.frame_index = f;
+            st.ts_ms = t0 + f * 500LL;
+            st.occupancy_state = cur[s];
+            st.person_count = cur[s] == vision::SeatOccupancyState::PERSON ? 1 : 0;
+            st.object_count = cur[s] == vision::SeatOccupancyState::OBJECT_ONLY ? 1 : 0;
+            st.person_conf_max = st.person_count > 0 ? 0.9f : 0.0f;
+        }
+    }
+    return out;
+}
+
+// number of seats whose row differs (state table of a judger in sequential mode)
+static int diffRows(SeatStateTable& a, SeatStateTable& b, int seats) {
+    int bad = 0;
+    for (SeatIdx i = 0; i < static_cast<SeatIdx>(seats); ++i) {
+        a.ensure(i);
+        b.ensure(i);
+        if (a.last_ts_ms[i] != b.last_ts_ms[i] || a.status_duration[i] != b.status_duration[i] ||
+            a.anomaly_duration[i] != b.anomaly_duration[i] || a.last_status[i] != b.last_status[i] ||
+            a.candidate_status[i] != b.candidate_status[i] || a.candidate_since_ms[i] != b.candidate_since_ms[i] ||
+            a.last_snapshot_ms[i] != b.last_snapshot_ms[i]) ++bad;
+    }
+    return bad;
+}
+
+int main(int argc, char* argv[]) {
+    int seats  = argc > 1 ? std::atoi(argv[1]) : 200;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 400;
+    if (seats <= 0 || frames < 2) {
+        std::cout << "Usage: judger_reshard_check [seats=200] [frames=400]" << std::endl;
+        return 1;
+    }
+    auto data = makeFrames(seats, frames);
+    const int half = frames / 2;
+
+    SeatStateJudger ref(nullptr);
+    ref.setVerbose(false);
+    SeatStateJudger j(nullptr);
+    j.setVerbose(false);
+
+    bool ok = true;
+    auto check = [&](const char* step) {
+        const int bad = diffRows(ref.stateTable(), j.stateTable(), seats);
+        std::cout << "  " << step << ": " << (bad == 0 ? "match" : "DIFFER") << " (" << bad << " seats)" << std::endl;
+        ok = ok && bad == 0;
+    };
+
+    for (int f = 0; f < half; ++f) ref.processFrame(data[f]);
+    j.setShardCount(2, 16);
+    for (int f = 0; f < half; ++f) j.processFrame(data[f]);
+
+    j.setShardCount(4, 16);   // 2 -> 4: the new shards start from the rows the old ones judged
+    j.setShardCount(1);
+    check("2 -> 4 -> 1 shards");
+
+    j.setShardCount(4, 16);
+    for (int f = half; f < frames; ++f) {
+        ref.processFrame(data[f]);
+        j.processFrame(data[f]);
+        if (f == half + (frames - half) / 2) j.setShardCount(2, 16);   // 4 -> 2 mid-stream
+    }
+    j.setShardCount(1);
+    check("4 -> 2 -> 1 shards, all frames");
+
+    std::cout << (ok ? "reshard check passed" : "reshard check FAILED") << std::endl;
+    return ok ? 0 : 2;
+}
@@ -0,0 +1,115 @@
+// judger_shard_bench: ShardedJudger scaling on a synthetic large floor
+//
+// 用法: ./judger_shard_bench [seats=2000] [frames=1000] [threads=1,2,4,8] [batch=64]
+//   - 参考结果: 单线程 SeatStateJudger::judgeSeat 顺序判定
+//   - 每个线程数 N: ShardedJudger(N) 按 batch 帧提交并 flush, 只计判定 + 合并耗时 (不连接数据库)
+//   - 对合并后的记录流做摘要, 与参考结果逐条比较, 确认分片合并是确定性的
+#include <seat_state_judger.hpp>
+#include <sharded_judger.hpp>
+#include <data_structures.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static std::vector<std::vector<SeatObservation>> makeFrames(int seats, int frames) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> flip(0, 99);
+    std::vector<vision::SeatOccupancyState> cur(seats, vision::SeatOccupancyState::FREE);
+
+    std::vector<std::vector<SeatObservation>> out(frames);
+    const int64_t t0 = 1700000000000LL;
+    for (int f = 0; f < frames; ++f) {
+        out[f].resize(seats);
+        for (int s = 0; s < seats; ++s) {
+            if (flip(gen) < 3) cur[s] = static_cast<vision::SeatOccupancyState>(flip(gen) % 3);
+            auto& o = out[f][s];
+            o.seat_id = "S" + std::to_string(s + 1);
+            o.seat_idx = s;
+            o.frame_id = f;
+            o.ts_ms = t0 + f * 500LL;
+            o.occupancy = cur[s];
+            o.person_count = cur[s] == vision::SeatOccupancyState::PERSON ? 1 : 0;
+            o.object_count = cur[s] == vision::SeatOccupancyState::OBJECT_ONLY ? 1 : 0;
+        }
+    }
+    return out;
+}
+
+// order-sensitive digest of one judged record
+static void mix(uint64_t& h, const B2CD_State& st, size_t n_alerts, bool has_event) {
+    auto step = [&](uint64_t v) { h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2); };
+    for (char c : st.seat_id) step(static_cast<unsigned char>(c));
+    step(static_cast<uint64_t>(st.status));
+    step(static_cast<uint64_t>(st.status_duration));
+    step(static_cast<uint64_t>(st.source_frame_id));
+    step(n_alerts);
+    step(has_event ? 1 : 0);
+}
+
+int main(int argc, char* argv[]) {
+    int seats  = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 1000;
+    std::vector<int> thread_list = {1, 2, 4, 8};
+    if (argc > 3) {
+        thread_list.clear();
+        std::stringstream ss(argv[3]); std::string tok;
+        while (std::getline(ss, tok, ',')) if (!tok.empty()) thread_list.push_back(std::atoi(tok.c_str()));
+    }
+    size_t batch = argc > 4 ? static_cast<size_t>(std::atoi(argv[4])) : 64;
+    if (seats <= 0 || frames <= 0 || batch == 0) {
+        std::cout << "Usage: judger_shard_bench [seats=2000] [frames=1000] [threads=1,2,4,8] [batch=64]" << std::endl;
+        return 1;
+    }
+
+    auto data = makeFrames(seats, frames);
+    // reference: sequential judgeSeat
+    uint64_t ref = 0;
+    double ms_ref = 0.0;
+    {
+        SeatStateJudger j(nullptr);
+        j.setVerbose(false);
+        B2CD_State st; std::vector<B2CD_Alert> alerts; std::optional<B2C_SeatSnapshot> snap; std::optional<B2C_SeatEvent> ev;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; ++f) {
+            for (auto& o : data[f]) {
+                alerts.clear(); snap.reset(); ev.reset();
+                j.judgeSeat(o, st, alerts, snap, ev);
+                mix(ref, st, alerts.size(), ev.has_value());
+            }
+        }
+        ms_ref = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    const double seat_frames = static_cast<double>(seats) * frames;
+    std::cout << std::fixed << std::setprecision(2)
+              << "seats=" << seats << " frames=" << frames << " batch=" << batch << "\n"
+              << "  sequential  : " << std::setw(10) << ms_ref << " ms  "
+              << std::setw(12) << seat_frames / (ms_ref / 1000.0) << " seat-frames/s\n";
+
+    bool all_match = true;
+    for (int n : thread_list) {
+        ShardedJudger sj(n);
+        uint64_t digest = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; ++f) {
+            sj.submit(data[f]);
+            if (sj.pendingFrames() >= batch || f + 1 == frames) {
+                for (const JudgedSeat* r : sj.flush()) mix(digest, r->state, r->alerts.size(), r->event.has_value());
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        bool match = digest == ref;
+        all_match = all_match && match;
+        std::cout << "  shards=" << std::setw(3) << n << "  : " << std::setw(10) << ms << " ms  "
+                  << std::setw(12) << seat_frames / (ms / 1000.0) << " seat-frames/s  "
+                  << std::setw(6) << (ms > 0 ? ms_ref / ms : 0.0) << "x  " << (match ? "match" : "DIFFER") << "\n";
+    }
+    std::cout << std::flush;
+    return all_match ? 0 : 2;
+}
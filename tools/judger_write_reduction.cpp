@@ -0,0 +1,141 @@
+// judger_write_reduction: rows written per day, legacy (every seat every frame) vs debounced transitions
+//
+// 用法: ./judger_write_reduction [jsonl 文件或目录]
+//   - 给出路径: 按文件名顺序回放录制的 JSONL (parseJsonlLine -> processFrameBatch)
+//   - 不给路径: 合成一天 (100 座位, 1 fps, 12 小时), 人在座时每帧有漏检 / 低置信度抖动
+//   - 两个 SeatStateJudger (不连接数据库) 分别使用默认配置和 JudgerDebounceConfig{enable=true},
+//     比较 writeStats() 的 event / snapshot / alert 行数
+#include <seat_state_judger.hpp>
+#include <data_structures.hpp>
+#include "seatui/vision/Types.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// one seat's day: alternating absent / present sessions; while present the detector misses ~5% of
+// frames and reports a low-confidence person on another ~10%; a few sessions leave a bag behind
+static std::vector<vision::SeatFrameState> makeFrame(int seats, int64_t f, std::mt19937& gen,
+                                                     std::vector<int>& remain, std::vector<int>& mode) {
+    std::uniform_int_distribution<int> pct(0, 99);
+    std::uniform_int_distribution<int> present_len(20 * 60, 120 * 60);
+    std::uniform_int_distribution<int> absent_len(5 * 60, 60 * 60);
+    std::uniform_real_distribution<float> strong(0.55f, 0.95f);
+    std::uniform_real_distribution<float> weak(0.32f, 0.49f);
+
+    std::vector<vision::SeatFrameState> out(seats);
+    for (int s = 0; s < seats; ++s) {
+        if (--remain[s] <= 0) {
+            // 0 = absent, 1 = present, 2 = object left on the seat
+            mode[s] = mode[s] == 1 ? (pct(gen) < 10 ? 2 : 0) : 1;
+            remain[s] = mode[s] == 1 ? present_len(gen) : absent_len(gen);
+        }
+        auto occ = vision::SeatOccupancyState::FREE;
+        float conf = 0.f;
+        if (mode[s] == 1) {
+            int r = pct(gen);
+            if (r >= 5) {
+                occ = vision::SeatOccupancyState::PERSON;
+                conf = r < 15 ? weak(gen) : strong(gen);
+            }
+        } else if (mode[s] == 2) {
+            occ = pct(gen) < 3 ? vision::SeatOccupancyState::FREE : vision::SeatOccupancyState::OBJECT_ONLY;
+        }
+        auto& st = out[s];
+        st.seat_id = s + 1;
+        st.ts_ms = 1700000000000LL + f * 1000LL;
+        st.frame_index = f;
+        st.occupancy_state = occ;
+        st.has_person = occ == vision::SeatOccupancyState::PERSON;
+        st.has_object = occ == vision::SeatOccupancyState::OBJECT_ONLY;
+        st.person_count = st.has_person ? 1 : 0;
+        st.object_count = st.has_object ? 1 : 0;
+        st.person_conf_max = conf;
+        st.object_conf_max = st.has_object ? 0.7f : 0.f;
+        st.seat_roi = cv::Rect(10 * s, 10, 80, 80);
+    }
+    return out;
+}
+
+static std::vector<std::string> listJsonl(const std::string& path) {
+    std::vector<std::string> files;
+    if (fs::is_directory(path)) {
+        for (const auto& e : fs::directory_iterator(path)) {
+            if (e.is_regular_file() && e.path().extension() == ".jsonl") files.push_back(e.path().string());
+        }
+        std::sort(files.begin(), files.end());
+    } else if (fs::is_regular_file(path)) {
+        files.push_back(path);
+    }
+    return files;
+}
+
+static void report(const char* name, const JudgerWriteStats& w) {
+    std::cout << "  " << std::left << std::setw(10) << name << std::right
+              << " seat-frames=" << std::setw(10) << w.seat_frames
+              << " events=" << std::setw(10) << w.events
+              << " snapshots=" << std::setw(10) << w.snapshots
+              << " alerts=" << std::setw(8) << w.alerts
+              << " rows=" << std::setw(10) << (w.events + w.snapshots + w.alerts) << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    SeatStateJudger legacy(nullptr);
+    SeatStateJudger debounced(nullptr);
+    legacy.setVerbose(false);
+    debounced.setVerbose(false);
+    JudgerDebounceConfig cfg;
+    cfg.enable = true;
+    debounced.setDebounce(cfg);
+
+    if (argc > 1) {
+        auto files = listJsonl(argv[1]);
+        if (files.empty()) {
+            std::cout << "No .jsonl input at " << argv[1] << std::endl;
+            return 1;
+        }
+        size_t frames = 0;
+        std::vector<A2B_Data> a2b;
+        std::vector<json> seats_j;
+        for (const auto& file : files) {
+            std::ifstream in(file);
+            std::string line;
+            while (std::getline(in, line)) {
+                for (SeatStateJudger* j : {&legacy, &debounced}) {
+                    if (!j->parseJsonlLine(line, a2b, seats_j)) break;
+                    j->processFrameBatch(a2b, seats_j);
+                    if (j == &legacy) ++frames;
+                }
+            }
+        }
+        std::cout << "replayed " << files.size() << " file(s), " << frames << " frames\n";
+    } else {
+        const int seats = 100;
+        const int64_t frames = 12 * 3600;
+        for (SeatStateJudger* j : {&legacy, &debounced}) {
+            std::mt19937 gen(11);
+            std::vector<int> remain(seats, 0), mode(seats, 1);
+            for (int64_t f = 0; f < frames; ++f) j->processFrame(makeFrame(seats, f, gen, remain, mode));
+        }
+        std::cout << "synthetic day: " << seats << " seats, " << frames << " frames (1 fps, 12 h)\n";
+    }
+
+    const auto& a = legacy.writeStats();
+    const auto& b = debounced.writeStats();
+    report("legacy", a);
+    report("debounced", b);
+    const double rows_a = static_cast<double>(a.events + a.snapshots + a.alerts);
+    const double rows_b = static_cast<double>(b.events + b.snapshots + b.alerts);
+    if (rows_b > 0) {
+        std::cout << std::fixed << std::setprecision(1) << "  reduction: " << rows_a / rows_b << "x fewer rows\n";
+    }
+    std::cout << std::flush;
+    return 0;
+}
@@ -0,0 +1,151 @@
+/*
+*   Name:  CompareOccupancyBackends.cpp
+*   Usage: compare_occupancy_backends <img_dir> [--config assets/vision/config/vision.yml] [--max N] [--warmup W]
+*   ==========================================================================================
+*   对同一组图片分别用两种占用后端跑 VisionA:
+*     - yolo            : 整帧检测 + 座位 ROI 归属
+*     - seat_classifier : 座位裁剪图批量分类
+*   输出: 每帧耗时 (mean / p50 / p95)、逐座位状态一致率、混淆矩阵 (行 = yolo, 列 = seat_classifier)
+*/
+#include "seatui/vision/VisionA.h"
+#include "seatui/vision/Config.h"
+#include "seatui/vision/Types.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace vision;
+namespace fs = std::filesystem;
+
+static const char* getOpt(int argc, char** argv, const std::string& key, const char* defv = nullptr) {
+    for (int i = 1; i + 1 < argc; ++i) if (key == argv[i]) return argv[i + 1]; return defv;
+}
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t k = static_cast<size_t>(p * (v.size() - 1) + 0.5);
+    return v[std::min(k, v.size() - 1)];
+}
+
+static double mean(const std::vector<double>& v) {
+    if (v.empty()) return 0.0;
+    double s = 0.0; for (double x : v) s += x; return s / v.size();
+}
+
+static int stateIndex(SeatOccupancyState s) {
+    switch (s) {
+        case SeatOccupancyState::FREE:              return 0;
+        case SeatOccupancyState::PERSON:            return 1;
+        case SeatOccupancyState::OBJECT_ONLY:       return 2;
+        case SeatOccupancyState::PERSON_AND_OBJECT: return 3;
+        default:                                    return 4;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argv[1][0] == '-') {
+        std::cout << "Usage: compare_occupancy_backends <img_dir> [--config path] [--max N] [--warmup W]\n";
+        return 0;
+    }
+    std::string img_dir = argv[1];
+    std::string cfg_path = getOpt(argc, argv, "--config", "assets/vision/config/vision.yml");
+    size_t max_frames = SIZE_MAX; if (const char* v = getOpt(argc, argv, "--max"))    max_frames = std::stoull(v);
+    size_t warmup = 3;            if (const char* v = getOpt(argc, argv, "--warmup")) warmup = std::stoull(v);
+
+    std::vector<std::string> files;
+    for (auto& e : fs::directory_iterator(img_dir)) {
+        if (!e.is_regular_file()) continue;
+        auto ext = e.path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        if (ext == ".jpg" || ext == ".jpeg" || ext == ".png" || ext == ".bmp") files.push_back(e.path().string());
+    }
+    std::sort(files.begin(), files.end());
+    if (files.size() > max_frames) files.resize(max_frames);
+    if (files.empty()) {
+        std::cerr << "No images found in " << img_dir << "\n";
+        return 1;
+    }
+
+    VisionConfig cfg_yolo = VisionConfig::fromYaml(cfg_path);
+    cfg_yolo.occupancy_backend = "yolo";
+    cfg_yolo.tracker_enable = false;            // 每帧都跑检测, 保证对比基准一致
+    VisionConfig cfg_cls = cfg_yolo;
+    cfg_cls.occupancy_backend = "seat_classifier";
+
+    VisionA vision_yolo(cfg_yolo);
+    VisionA vision_cls(cfg_cls);
+    // VisionA 在分类器未就绪时静默回退为 yolo, 那样对比的是 yolo 对 yolo
+    if (vision_cls.occupancyBackend() != "seat_classifier") {
+        std::cerr << "Seat classifier backend failed to load (seat_cls_model_path = " << cfg_cls.seat_cls_model_path
+                  << "), nothing to compare\n";
+        return 1;
+    }
+
+    std::vector<double> lat_yolo, lat_cls;
+    long long confusion[5][5] = {};
+    long long seats_total = 0, seats_agree = 0;
+
+    int64_t fi = 0;
+    for (const auto& f : files) {
+        cv::Mat img = cv::imread(f);
+        if (img.empty()) { std::cerr << "skip unreadable: " << f << "\n"; continue; }
+        int64_t ts = fi * 1000;
+
+        auto t0 = std::chrono::steady_clock::now();
+        auto states_yolo = vision_yolo.processFrame(img, ts, fi);
+        auto t1 = std::chrono::steady_clock::now();
+        auto states_cls = vision_cls.processFrame(img, ts, fi);
+        auto t2 = std::chrono::steady_clock::now();
+
+        if (static_cast<size_t>(fi) >= warmup) {
+            lat_yolo.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+            lat_cls.push_back(std::chrono::duration<double, std::milli>(t2 - t1).count());
+        }
+
+        // 两个后端使用同一份座位配置, 输出顺序一致; 仍按 seat_id 对齐以防万一
+        for (const auto& sy : states_yolo) {
+            auto it = std::find_if(states_cls.begin(), states_cls.end(),
+                                   [&](const SeatFrameState& s) { return s.seat_id == sy.seat_id; });
+            if (it == states_cls.end()) continue;
+            int r = stateIndex(sy.occupancy_state), c = stateIndex(it->occupancy_state);
+            confusion[r][c] += 1;
+            seats_total += 1;
+            if (r == c) seats_agree += 1;
+        }
+        ++fi;
+    }
+
+    const char* names[5] = {"FREE", "PERSON", "OBJECT", "P+O", "UNKNOWN"};
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n==== Occupancy backend comparison ====\n"
+              << "frames: " << fi << " (warmup " << warmup << " excluded from latency)\n"
+              << "seats : " << vision_yolo.seatCount() << "\n\n"
+              << "latency per frame (ms)      mean     p50     p95\n"
+              << "  yolo               " << std::setw(9) << mean(lat_yolo)
+              << std::setw(8) << percentile(lat_yolo, 0.50) << std::setw(8) << percentile(lat_yolo, 0.95) << "\n"
+              << "  seat_classifier    " << std::setw(9) << mean(lat_cls)
+              << std::setw(8) << percentile(lat_cls, 0.50) << std::setw(8) << percentile(lat_cls, 0.95) << "\n";
+    if (mean(lat_cls) > 0.0)
+        std::cout << "  speedup (mean)     " << mean(lat_yolo) / mean(lat_cls) << "x\n";
+
+    std::cout << "\nagreement: " << seats_agree << " / " << seats_total << " seat-frames";
+    if (seats_total > 0) std::cout << " (" << 100.0 * seats_agree / seats_total << "%)";
+    std::cout << "\n\nconfusion (rows = yolo, cols = seat_classifier)\n" << std::setw(10) << "";
+    for (auto n : names) std::cout << std::setw(9) << n;
+    std::cout << "\n";
+    for (int r = 0; r < 5; ++r) {
+        std::cout << std::setw(10) << names[r];
+        for (int c = 0; c < 5; ++c) std::cout << std::setw(9) << confusion[r][c];
+        std::cout << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+*   Name:  IngestBenchmark.cpp
+*   Usage: ingest_benchmark <img_dir> [--max N] [--workers 1,2,4,8] [--target 640] [--e2e] [--config path]
+*   ==========================================================================================
+*   图像目录读入基准: 串行 imread vs ParallelImageReader (N 线程 + 有序交付)
+*     - 默认仅测解码 (含降采样解码 + resize 回原尺寸), 反映离线回灌时的 I/O + JPEG 解码瓶颈
+*     - --e2e: 额外跑完整 FrameProcessor::imageProcess (ingest_workers = 0 vs 最大 workers), 含 VisionA 推理
+*/
+#include "seatui/vision/ImageIngest.h"
+#include "seatui/vision/FrameProcessor.h"
+#include "seatui/vision/VisionA.h"
+#include "seatui/vision/Config.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace vision;
+
+static bool hasFlag(int argc, char** argv, const std::string& flag) {
+    for (int i = 1; i < argc; ++i) if (flag == argv[i]) return true; return false;
+}
+static const char* getOpt(int argc, char** argv, const std::string& key, const char* defv = nullptr) {
+    for (int i = 1; i + 1 < argc; ++i) if (key == argv[i]) return argv[i + 1]; return defv;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void report(const std::string& name, size_t frames, size_t failed, double sec) {
+    std::cout << "  " << std::left << std::setw(28) << name << std::right
+              << std::setw(8) << frames << " frames  "
+              << std::setw(8) << std::fixed << std::setprecision(2) << sec << " s  "
+              << std::setw(9) << (sec > 0 ? frames / sec : 0.0) << " fps"
+              << (failed ? "  (failed " + std::to_string(failed) + ")" : "") << "\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || hasFlag(argc, argv, "-h") || hasFlag(argc, argv, "--help")) {
+        std::cout << "Usage: ingest_benchmark <img_dir> [--max N] [--workers 1,2,4,8] [--target 640] [--e2e] [--config path]\n";
+        return 0;
+    }
+    std::string img_dir = argv[1];
+    size_t max_frames = 3000;  if (const char* v = getOpt(argc, argv, "--max"))    max_frames = std::stoull(v);
+    int target = 640;          if (const char* v = getOpt(argc, argv, "--target")) target = std::atoi(v);
+    std::vector<int> worker_list = {1, 2, 4, 8};
+    if (const char* v = getOpt(argc, argv, "--workers")) {
+        worker_list.clear();
+        std::stringstream ss(v); std::string tok;
+        while (std::getline(ss, tok, ',')) if (!tok.empty()) worker_list.push_back(std::atoi(tok.c_str()));
+    }
+
+    auto files = ParallelImageReader::listImageFiles(img_dir);
+    if (files.size() > max_frames) files.resize(max_frames);
+    if (files.empty()) {
+        std::cerr << "No images found in " << img_dir << "\n";
+        return 1;
+    }
+    cv::Mat probe = cv::imread(files.front().string());
+    const cv::Size original = probe.size();
+    const int reduced_flag = ParallelImageReader::chooseReducedFlag(original, target);
+
+    std::cout << "==== Image ingestion benchmark ====\n"
+              << "dir: " << img_dir << ", frames: " << files.size()
+              << ", size: " << original.width << "x" << original.height
+              << ", reduced flag for target " << target << ": " << reduced_flag << "\n\n";
+
+    // 1. 串行 imread (当前 imageProcess 路径)
+    {
+        size_t failed = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (auto& f : files) if (cv::imread(f.string()).empty()) ++failed;
+        report("serial imread", files.size(), failed, secondsSince(t0));
+    }
+
+    // 2. 并行 (全尺寸 / 降采样) 解码
+    for (int reduced = 0; reduced <= (reduced_flag != cv::IMREAD_COLOR ? 1 : 0); ++reduced) {
+        for (int w : worker_list) {
+            size_t failed = 0, got = 0, expect = 0;
+            bool in_order = true;
+            auto t0 = std::chrono::steady_clock::now();
+            {
+                ParallelImageReader reader(files, w, 4 * w,
+                                           reduced ? reduced_flag : cv::IMREAD_COLOR,
+                                           reduced ? original : cv::Size());
+                size_t idx = 0; cv::Mat img;
+                while (reader.next(idx, img)) {
+                    if (idx != expect++) in_order = false;
+                    if (img.empty()) ++failed;
+                    ++got;
+                }
+            }
+            std::string name = std::string(reduced ? "parallel reduced" : "parallel full") + " w=" + std::to_string(w);
+            report(name, got, failed, secondsSince(t0));
+            if (!in_order) std::cerr << "  !! out-of-order delivery detected\n";
+        }
+    }
+
+    // 3. 端到端 imageProcess (含推理), 串行 vs 最大 workers
+    if (hasFlag(argc, argv, "--e2e")) {
+        std::string cfg_path = getOpt(argc, argv, "--config", "assets/vision/config/vision.yml");
+        VisionConfig cfg = VisionConfig::fromYaml(cfg_path);
+        std::ofstream ofs;
+        int max_w = *std::max_element(worker_list.begin(), worker_list.end());
+        for (int w : {0, max_w}) {
+            cfg.ingest_workers = w;
+            VisionA vision(cfg);
+            auto t0 = std::chrono::steady_clock::now();
+            size_t n = FrameProcessor::imageProcess(img_dir, "../../out", ofs, cfg, vision, files.size(), 100, 0);
+            report(w == 0 ? "e2e imageProcess serial" : "e2e imageProcess w=" + std::to_string(w), n, 0, secondsSince(t0));
+        }
+    }
+    return 0;
+}